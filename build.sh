@@ -1 +1,25 @@
-g++ src/main.cpp src/Animation.cpp src/Button.cpp src/Card.cpp src/CardRenderer.cpp src/Game.cpp src/GameEngine.cpp src/SoundManager.cpp src/Utility.cpp -o solitaire -lSDL2 -lSDL2_ttf -lSDL2_image -lSDL2_mixer
+# Rules engine: no SDL, shared by the game and the headless tools
+CORE="src/AssetBundle.cpp src/Bot.cpp src/Card.cpp src/DealGenerator.cpp src/DealPool.cpp src/Game.cpp src/HintService.cpp src/LatencyMeter.cpp src/Layout.cpp src/MappedFile.cpp src/MoveGen.cpp src/MoveJournal.cpp src/Replay.cpp src/Simulation.cpp src/SolvabilityDB.cpp src/Solver.cpp src/StallDetector.cpp src/TranspositionTable.cpp src/Utility.cpp src/WinnabilityMonitor.cpp src/WinnableDeals.cpp"
+mkdir -p build/core
+for f in $CORE; do g++ -O2 -c $f -o build/core/$(basename $f .cpp).o || exit 1; done
+rm -f build/libsolitaire_core.a
+ar rcs build/libsolitaire_core.a build/core/*.o
+
+# PROFILE=1 ./build.sh compiles in the frame profiler (F1 overlay, F2 trace)
+GUI_FLAGS=""
+[ -n "$PROFILE" ] && GUI_FLAGS="-DSOLITAIRE_PROFILE"
+# EMBED_ASSETS=1 ./build.sh links assets.sab (from ./assetpack) into the binary
+GUI_OBJS=""
+if [ -n "$EMBED_ASSETS" ]; then
+  ld -r -b binary assets.sab -o build/assets_sab.o || exit 1
+  GUI_FLAGS="$GUI_FLAGS -DSOLITAIRE_EMBED_ASSETS"
+  GUI_OBJS="build/assets_sab.o"
+fi
+g++ $GUI_FLAGS src/main.cpp src/AssetLoader.cpp src/Animation.cpp src/BoardCache.cpp src/Button.cpp src/CardRenderer.cpp src/FrameScheduler.cpp src/GameEngine.cpp src/Profiler.cpp src/RenderBatch.cpp src/SoundManager.cpp src/TextCache.cpp src/WinCascade.cpp $GUI_OBJS build/libsolitaire_core.a -o solitaire -pthread -lSDL2 -lSDL2_ttf -lSDL2_image -lSDL2_mixer
+g++ -O2 tools/dealgen.cpp build/libsolitaire_core.a -o dealgen -pthread
+g++ -O2 tools/dbgen.cpp build/libsolitaire_core.a -o dbgen -pthread
+g++ -O2 tools/sim.cpp build/libsolitaire_core.a -o solitaire-sim -pthread
+g++ -O2 tools/bench.cpp build/libsolitaire_core.a -o solitaire-bench -pthread
+# ParallelSolver against Solver, splitting work at every node: ./solver-check [deals] [threads]
+g++ -O2 -DSOLITAIRE_SOLVER_POLL_INTERVAL=1 tools/solvercheck.cpp src/Solver.cpp build/libsolitaire_core.a -o solver-check -pthread
+g++ -O2 tools/assetpack.cpp build/libsolitaire_core.a -o assetpack -lSDL2 -lSDL2_image
@@ -1,31 +1,62 @@
 // include/Animation.h
 #pragma once
 
+#include <cstdint>
 #include <vector>
-#include <functional>
 #include <SDL2/SDL.h>
 #include "Card.h"
+#include "Move.h"
 
-enum class AnimType { MoveCard, FlipCard };
+class CardRenderer;
+
+// What the owner does once an animation lands. Completion is reported as
+// an event after AnimationTimeline::advance instead of running a callback
+// from inside the pool.
+enum class AnimDone : uint8_t {
+    Nothing,
+    CommitMove, // put `card` back on move.from, then commit `move`
+};
 
 struct Animation {
-    AnimType type;
-    Card card;
-    int srcX, srcY, dstX, dstY;
-    Uint32 startTime, duration;
-    std::function<void()> onComplete;
+    Card     card;
+    AnimDone done;
+    Move     move;
+    int      srcX, srcY, dstX, dstY;
+    Uint32   startTime, duration; // the card waits at src until startTime
+};
+
+struct AnimEvent {
+    AnimDone done;
+    Card     card;
+    Move     move;
 };
 
-// Active animations
-extern std::vector<Animation> animations;
+// Cards in flight, in a pool allocated once. Finished animations are
+// swap-removed, so removal is O(1) and the pool never reallocates; the
+// cost is that draw order among cards still flying may change.
+class AnimationTimeline {
+public:
+    static constexpr int CAPACITY = 4096;
 
+    AnimationTimeline();
 
-// Enqueue a move‐card animation
-void animateCardMove(const Card& c,
-                     int fromX,int fromY,
-                     int toX,int toY,
-                     Uint32 ms,
-                     std::function<void()> commit);
+    // False, with nothing queued, when the pool is full
+    bool add(const Animation& a);
+    bool moveCard(const Card& c, int fromX, int fromY, int toX, int toY, Uint32 ms,
+                  AnimDone done = AnimDone::Nothing, Move move = Move{}, Uint32 delay = 0);
 
-// Render & advance animations
-void updateAnimations(class CardRenderer& renderer);
+    // Retires every animation finished at `now`; their events are then
+    // event(0) .. event(n-1) until the next advance
+    int  advance(Uint32 now);
+    const AnimEvent& event(int i) const { return mEvents[i]; }
+    void draw(Uint32 now, CardRenderer& renderer) const;
+
+    bool empty() const { return mCount == 0; }
+    int  size() const { return mCount; }
+    void clear() { mCount = 0; }
+
+private:
+    std::vector<Animation> mPool;   // CAPACITY slots, first mCount live
+    std::vector<AnimEvent> mEvents; // CAPACITY slots
+    int                    mCount = 0;
+};
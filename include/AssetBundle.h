@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+
+enum AssetKind : uint32_t {
+    ASSET_RAW  = 0, // file bytes as-is (font, sound)
+    ASSET_RGBA = 1, // decoded image, width*height pixels of R,G,B,A bytes
+};
+
+// On-disk layout, little-endian, read in place through a memory map:
+//   header  (16 bytes)
+//   entries (count x 80 bytes)
+//   payloads, each starting on a 64-byte boundary
+// Entries are named by the path the asset would have as a loose file.
+struct AssetBundleHeader {
+    char     magic[4];  // "SAB1"
+    uint32_t version;
+    uint32_t count;
+    uint32_t reserved;
+};
+struct AssetEntry {
+    char     name[48];  // NUL-terminated
+    uint32_t kind;      // AssetKind
+    uint32_t width, height;
+    uint32_t reserved;
+    uint64_t offset;    // from the start of the bundle
+    uint64_t size;
+};
+static_assert(sizeof(AssetBundleHeader) == 16 && sizeof(AssetEntry) == 80,
+              "bundle layout is part of the file format");
+
+struct AssetView {
+    AssetKind            kind;
+    int                  width, height;
+    const unsigned char* data;
+    size_t               size;
+};
+
+struct AssetSource {
+    std::string                name;
+    AssetKind                  kind = ASSET_RAW;
+    int                        width = 0, height = 0;
+    std::vector<unsigned char> bytes;
+};
+
+bool writeAssetBundle(const char* path, const std::vector<AssetSource>& assets);
+
+// Assets straight out of one mapped file (or a bundle linked into the
+// binary); nothing is copied or decoded
+class AssetBundle {
+public:
+    bool open(const char* path);
+    bool open(const unsigned char* data, size_t size);
+    void close();
+    bool isOpen() const { return mEntries != nullptr; }
+
+    bool find(const char* name, AssetView& out) const;
+
+private:
+    MappedFile        mFile;
+    const unsigned char* mData = nullptr;
+    size_t            mSize = 0;
+    const AssetEntry* mEntries = nullptr;
+    uint32_t          mCount = 0;
+};
@@ -0,0 +1,37 @@
+// include/AssetLoader.h
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <cstddef>
+#include "AssetBundle.h"
+
+enum TextureId {
+    TEX_SPADE, TEX_HEART, TEX_DIAMOND, TEX_CLUB,
+    TEX_CARDBACK, TEX_JACK, TEX_QUEEN, TEX_KING,
+    TEXTURE_COUNT
+};
+// Loose file (and bundle entry name) of each TextureId
+extern const char* const TEXTURE_FILES[TEXTURE_COUNT];
+
+// Everything needed before the first frame. The textures are handed to
+// CardRenderer; the bundle stays mapped because the font and the sound
+// are read from it.
+struct StartupAssets {
+    AssetBundle          bundle;
+    SDL_Texture*         textures[TEXTURE_COUNT] = {};
+    TTF_Font*            font = nullptr;
+    const unsigned char* moveSound = nullptr; // WAV bytes, null: load MOVE_SOUND_FILE
+    size_t               moveSoundSize = 0;
+};
+
+// Takes the bundle linked into the binary, else ASSET_BUNDLE_FILE, and
+// only creates textures from its pixels. Without a bundle the PNGs are
+// decoded on worker threads while the font loads; only texture creation
+// runs on the calling (render) thread. False if the font is missing.
+bool loadStartupAssets(SDL_Renderer* renderer, StartupAssets& out);
+
+// The card textures alone, from `bundle` where it has them and the loose
+// files otherwise; after SDL_RENDER_DEVICE_RESET every texture is lost
+void loadCardTextures(SDL_Renderer* renderer, const AssetBundle& bundle,
+                      SDL_Texture* out[TEXTURE_COUNT]);
@@ -0,0 +1,37 @@
+// include/BoardCache.h
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <array>
+#include "Game.h"
+
+class CardRenderer;
+class BoardLayout;
+
+// Retained copy of the settled board (felt, pile outlines and every card
+// resting on a pile) in a window-sized render target. Each frame update()
+// compares the piles with what the texture already shows and redraws only
+// the regions of piles that changed; cards being dragged or animated are
+// not on a pile and are drawn on top by the caller.
+class BoardCache {
+public:
+    explicit BoardCache(SDL_Renderer* renderer);
+    ~BoardCache();
+    BoardCache(const BoardCache&) = delete;
+    BoardCache& operator=(const BoardCache&) = delete;
+
+    // False if the renderer cannot draw to textures; draw immediately then
+    bool valid() const { return mTexture != nullptr; }
+    // Brings the texture up to date with `g`, laid out by `layout`;
+    // returns how many piles it redrew
+    int  update(const Game& g, const BoardLayout& layout, CardRenderer& cards);
+    void draw();
+    // Everything is redrawn on the next update (e.g. render targets reset)
+    void invalidate() { mAllDirty = true; }
+
+private:
+    SDL_Renderer*                       mRenderer;
+    SDL_Texture*                        mTexture = nullptr;
+    std::array<CardStack, PILE_COUNT>   mDrawn;
+    bool                                mAllDirty = true;
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Game.h"
+#include "MoveGen.h"
+#include "Solver.h"
+
+// How much a move helps a player who cannot see face-down cards, or -1 if
+// it is never worth playing. Shared by the hint button and the greedy bot.
+int rankMove(const Game& g, const Move& m);
+
+// Highest-ranked legal move; false if nothing is worth playing
+bool bestMove(const Game& g, int drawCount, Move& m);
+
+enum class BotPolicy : uint8_t { Random, Greedy, Solver };
+
+const char* policyName(BotPolicy p);
+bool parsePolicy(const char* name, BotPolicy& out);
+
+struct GameOutcome {
+    bool won   = false;
+    int  moves = 0; // Game::moveCount when play stopped
+};
+
+// Plays whole seeded games without a display. Deterministic: the same
+// policy, draw count and seed always give the same outcome.
+class Bot {
+public:
+    Bot(BotPolicy policy, int drawCount, int maxMoves = 1000,
+        SolverLimits limits = SolverLimits{200000, 60000});
+    // `line`, if given, receives every move played (for replays)
+    GameOutcome play(uint64_t seed, std::vector<Move>* line = nullptr);
+
+private:
+    bool playMoves(Game& g, uint64_t seed, std::vector<Move>* line); // random and greedy
+    bool playSolved(Game& g, std::vector<Move>* line);
+
+    BotPolicy               mPolicy;
+    int                     mDrawCount;
+    int                     mMaxMoves;
+    SolverLimits            mLimits;
+    std::unique_ptr<Solver> mSolver; // solver policy only
+};
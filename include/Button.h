@@ -5,6 +5,7 @@
 #include <SDL2/SDL_ttf.h>
 #include <string>
 #include <functional>
+#include "TextCache.h"
 
 enum class ButtonState { Normal, Hovered, Pressed };
 class Button {
@@ -14,7 +15,7 @@ public:
            std::function<void()> callback);
 
     void update(int mouseX,int mouseY,bool mouseDown);
-    void render(SDL_Renderer* renderer, TTF_Font* font);
+    void render(SDL_Renderer* renderer, TextCache& text);
     bool isClicked(int x,int y) const;
     void onClick();
 
@@ -1,28 +1,65 @@
-// include/Card.h
 #pragma once
 
+#include <cstdint>
 #include <string>
-#include <vector>
 
 // Game modes
 enum Mode { RANDOM, WINNING };
 // Pile types
-enum PileType { STOCK, WASTE, TABLEAU, FOUNDATION };
+enum PileType : uint8_t { STOCK, WASTE, TABLEAU, FOUNDATION };
 // Overall UI/game state
-enum GameState { MENU, PLAYING, PAUSED, SETTINGS, STATISTICS };
+enum GameState { MENU, PLAYING, PAUSED, SETTINGS, STATISTICS, REPLAY };
 
-// Single card
+// Single card, packed into one byte
 struct Card {
-    int value; // 1–13
-    int suit;  // 0=♠,1=♥,2=♦,3=♣
-    bool faceUp;
+    uint8_t value  : 4; // 1–13
+    uint8_t suit   : 2; // 0=♠,1=♥,2=♦,3=♣
+    uint8_t faceUp : 1;
 };
+static_assert(sizeof(Card) == 1, "Card must stay one byte");
 
-// A pile of cards
+inline Card makeCard(int value, int suit, bool faceUp) {
+    Card c{};
+    c.value = value; c.suit = suit; c.faceUp = faceUp;
+    return c;
+}
+
+// 0..51, suit-major
+inline int cardId(const Card& c) { return c.suit * 13 + c.value - 1; }
+
+// Largest pile a legal game can build (24 cards in stock/waste)
+constexpr int PILE_CAPACITY = 24;
+
+// Fixed-capacity card stack; the subset of std::vector the rules need
+struct CardStack {
+    Card    data[PILE_CAPACITY]{};
+    uint8_t count = 0;
+
+    bool   empty() const { return count == 0; }
+    size_t size()  const { return count; }
+    void   clear()       { count = 0; }
+    void   resize(size_t n) { count = uint8_t(n); }
+
+    Card&       operator[](size_t i)       { return data[i]; }
+    const Card& operator[](size_t i) const { return data[i]; }
+    Card&       front()       { return data[0]; }
+    const Card& front() const { return data[0]; }
+    Card&       back()        { return data[count - 1]; }
+    const Card& back()  const { return data[count - 1]; }
+
+    void push_back(Card c) { data[count++] = c; }
+    void pop_back()        { --count; }
+
+    Card*       begin()       { return data; }
+    Card*       end()         { return data + count; }
+    const Card* begin() const { return data; }
+    const Card* end()   const { return data + count; }
+};
+
+// A pile of cards; screen position lives in Layout.h
 struct Pile {
-    PileType type;
-    int x, y;
-    std::vector<Card> cards;
+    PileType  type;
+    CardStack cards;
 };
 
 // Convert 1→"A", 11→"J", etc.
@@ -5,17 +5,38 @@
 #include <SDL2/SDL_ttf.h>
 #include <string>
 #include "Card.h"
+#include "TextCache.h"
+#include "RenderBatch.h"
+#include "AssetLoader.h"
 
-// Draws cards & text
+// Draws cards & text. All 52 faces and the back are rasterized once into
+// an atlas texture, so drawing a card is a single SDL_RenderCopy.
 class CardRenderer {
 public:
-    CardRenderer(SDL_Renderer* renderer, TTF_Font* font);
+    // Takes ownership of `textures` (see loadStartupAssets)
+    CardRenderer(SDL_Renderer* renderer, TTF_Font* font, SDL_Texture* const textures[TEXTURE_COUNT]);
     ~CardRenderer();
     void drawCard(int x,int y,const Card& card);
+    // Between these, drawCard only queues a quad; flushBatch submits them
+    // all in one draw call and returns the number of calls used
+    void beginBatch();
+    int  flushBatch();
     void renderText(const std::string& text,int x,int y);
+    TextCache& textCache() { return mText; }
+    // Render targets lose their contents on SDL_RENDER_TARGETS_RESET
+    void rebuildAtlas();
+    // A device reset loses every texture: adopts freshly loaded ones in
+    // place of the old and rebuilds the atlas from them
+    void replaceTextures(SDL_Texture* const textures[TEXTURE_COUNT]);
 private:
+    // Immediate-mode drawing, used to fill the atlas (or instead of it
+    // when the renderer cannot draw to textures)
+    void adoptTextures(SDL_Texture* const textures[TEXTURE_COUNT]);
+    void destroyTextures();
+    void rasterizeCard(int x,int y,const Card& card);
     void drawPips(int x,int y,int w,int h,int value,int suit);
     void drawPipTexture(SDL_Texture* tex,int cx,int cy,int scale);
+    SDL_Rect atlasRect(const Card& card) const;
 
     SDL_Renderer* mRenderer;
     TTF_Font*     mFont;
@@ -27,4 +48,8 @@ private:
     SDL_Texture*  mJackTexture;
     SDL_Texture*  mQueenTexture;
     SDL_Texture*  mKingTexture;
+    SDL_Texture*  mAtlas = nullptr; // 13 values x 4 suits, back in row 4
+    TextCache     mText;
+    RenderBatch   mBatch;
+    bool          mBatching = false;
 };
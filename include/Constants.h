@@ -5,11 +5,26 @@
 constexpr int WINDOW_WIDTH = 1024;
 constexpr int WINDOW_HEIGHT = 768;
 
+// Table felt colour
+constexpr int TABLE_COLOR_R = 0;
+constexpr int TABLE_COLOR_G = 100;
+constexpr int TABLE_COLOR_B = 0;
+
 // Card dimensions & layout
 constexpr int CARD_WIDTH = 75;
 constexpr int CARD_HEIGHT = 110;
 constexpr int CARD_SPACING_Y = 30;
 
+// Display rate the frame scheduler paces animation to
+constexpr int FRAME_HZ = 60;
+
+// How long a hint stays on screen
+constexpr unsigned HINT_MS = 2000;
+// Time the hint search may take per position
+constexpr unsigned HINT_BUDGET_MS = 20;
+// Time the "can still win" check may spend per position
+constexpr unsigned WINNABLE_BUDGET_MS = 1500;
+
 // Font settings
 constexpr char FONT_FILE[] = "fonts/arial.ttf";
 constexpr int FONT_SIZE = 24;
@@ -26,3 +41,23 @@ constexpr char KING_IMG[]     = "textures/king.png";
 
 // Sound file paths
 constexpr char MOVE_SOUND_FILE[] = "sounds/move.wav";
+
+// Every file above, pre-decoded into one mapped file (see tools/assetpack.cpp);
+// the loose files are only read when it is missing
+constexpr char ASSET_BUNDLE_FILE[] = "assets.sab";
+
+// Offline solver results (optional; see tools/dbgen.cpp)
+constexpr char SOLVABILITY_DB_FILE[] = "data/solvability.db";
+
+// Every finished game is saved here; the menu replays the last one
+constexpr char REPLAY_DIR[]       = "replays";
+constexpr char REPLAY_LAST_FILE[] = "replays/last.rpl";
+
+// Written by F2 in profiling builds (PROFILE=1 ./build.sh)
+constexpr char PROFILE_TRACE_FILE[] = "solitaire-trace.json";
+
+// Replay viewer scrub bar
+constexpr int REPLAY_BAR_X = 50;
+constexpr int REPLAY_BAR_Y = 700;
+constexpr int REPLAY_BAR_W = 700;
+constexpr int REPLAY_BAR_H = 16;
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "Game.h"
+#include "Solver.h"
+
+enum class Difficulty { Easy, Medium, Hard };
+constexpr int DIFFICULTY_COUNT = 3;
+
+const char* difficultyName(Difficulty d);
+
+// Budget used to grade deals. Only the node cap matters, so a grade is
+// reproducible on any machine. Raising `stop` abandons the solve.
+SolverLimits gradingLimits(const std::atomic<bool>* stop = nullptr);
+
+// Grade a deal the solver proved winnable, by how much search it took
+Difficulty classifyDifficulty(const SolveResult& result);
+
+// Deal `seed` and run the solver on it under gradingLimits(stop)
+SolveResult solveDeal(Solver& solver,uint64_t seed,int drawCount,
+                      const std::atomic<bool>* stop = nullptr);
+
+// Prove `seed` winnable and grade it; false if unsolvable, too hard to
+// prove or stopped
+bool gradeDeal(Solver& solver,uint64_t seed,int drawCount,Difficulty& out,
+               const std::atomic<bool>* stop = nullptr);
+
+// Scan seeds upward from `firstSeed` on `threads` threads (0 = all) and
+// return the first `count` (in seed order) proven winnable at `difficulty`
+std::vector<uint64_t> findWinnableDeals(int count,Difficulty difficulty,int drawCount,
+                                        uint64_t firstSeed,int threads = 0);
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include "DealGenerator.h"
+
+// Winnable deal numbers for new games. take() never searches: it hands out
+// freshly proven seeds when a background thread has some ready, and falls
+// back to the table baked in at build time (WinnableDeals.cpp) otherwise.
+class DealPool {
+public:
+    explicit DealPool(int drawCount);
+    ~DealPool();
+    uint64_t take(Difficulty difficulty);
+
+private:
+    void refill();
+
+    int                       mDrawCount;
+    Solver                    mSolver;
+    std::deque<uint64_t>      mFresh[DIFFICULTY_COUNT];
+    size_t                    mNextBuiltin[DIFFICULTY_COUNT];
+    std::mutex                mLock;
+    std::condition_variable   mWake;
+    std::atomic<bool>         mStop{false};
+    std::thread               mWorker;
+};
+
+// Precomputed winnable seeds, indexed [drawCount==3][difficulty]
+extern const uint64_t* const BUILTIN_WINNABLE_DEALS[2][DIFFICULTY_COUNT];
+extern const int BUILTIN_WINNABLE_COUNT;
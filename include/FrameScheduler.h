@@ -0,0 +1,31 @@
+// include/FrameScheduler.h
+#pragma once
+
+#include <SDL2/SDL.h>
+#include "Constants.h"
+
+// Paces the main loop. While something moves, frames are paced by vsync,
+// or by sleeping out the rest of the frame period when vsync is
+// unavailable, so frame timing does not drift with render cost. When
+// nothing moves the loop sleeps in SDL_WaitEventTimeout until input or
+// the next timed update.
+class FrameScheduler {
+public:
+    explicit FrameScheduler(SDL_Renderer* renderer, int refreshHz = FRAME_HZ);
+
+    // Milliseconds to wait for an event before the next frame. `nextUpdateMs`
+    // is when the engine next changes by itself (-1 for never).
+    int  waitTimeout(bool animating, int nextUpdateMs);
+    void framePresented();
+
+private:
+    SDL_Renderer* mRenderer;
+    Uint32        mPeriodMs;
+    Uint32        mLastPresent = 0;
+    bool          mVSync = false;       // currently enabled
+    bool          mVSyncWorks = true;   // SDL_RenderSetVSync succeeded
+};
+
+// Longest sleep when nothing is scheduled, so work finished on background
+// threads is picked up even if nobody posts an event for it
+constexpr int MAX_IDLE_WAIT_MS = 1000;
@@ -1,22 +1,55 @@
-// include/Game.h
 #pragma once
 
-#include <vector>
+#include <array>
+#include <cstdint>
 #include "Card.h"
 #include "Constants.h"
+#include "Move.h"
 
-// Core solitaire logic
+// Pile slots in Game::piles
+constexpr int STOCK_PILE       = 0;
+constexpr int WASTE_PILE       = 1;
+constexpr int FIRST_FOUNDATION = 2;
+constexpr int FIRST_TABLEAU    = 6;
+constexpr int PILE_COUNT       = 13;
+
+// Core solitaire logic. Plain value type: copying a Game never allocates.
 class Game {
 public:
     Game();
     Mode mode;
     int score, moveCount;
-    std::vector<Card> deck;
-    std::vector<Pile> piles;
+    uint64_t seed; // deal number the deck was shuffled from
+    uint64_t hash; // Zobrist hash of piles, kept current by the mutators below
+    std::array<Card,52> deck;
+    std::array<Pile,PILE_COUNT> piles;
 
-    void initializeDeck();
+    // Same seed, same deal, on every platform and standard library
+    void initializeDeck(uint64_t dealSeed);
     void setupPiles();
     bool canPlaceOnFoundation(const Card& c,const Pile& f) const;
     bool moveCardToFoundation(int fromPile,int cardIdx);
     void handleStockClick(int drawCount);
+
+    // Reversible moves: applyMove fills in Move::flipped, undoMove reverts it
+    bool stockMove(int drawCount,Move& m) const;
+    void applyMove(Move& m);
+    void undoMove(const Move& m);
+
+    // All pile mutations go through these so `hash` stays incremental
+    void pushCard(int pile,Card c);
+    Card popCard(int pile);
+    Card removeCard(int pile,int cardIdx);
+    void setFaceUp(int pile,int cardIdx,bool up);
+    uint64_t computeHash() const;
 };
+
+// Game::hash with the draw setting folded in, which changes what the stock
+// does: the key for caches of per-position analysis. Never 0.
+inline uint64_t positionKey(const Game& g, int drawCount) {
+    uint64_t k = g.hash ^ (drawCount == 3 ? 0x9E3779B97F4A7C15ull : 0);
+    return k ? k : 1;
+}
+
+// A fresh deal number for an unseeded game
+uint64_t randomDealSeed();
@@ -3,7 +3,7 @@
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
-#include <stack>
+#include <array>
 #include <vector>
 #include <string>
 #include "Game.h"
@@ -11,11 +11,21 @@
 #include "SoundManager.h"
 #include "Button.h"
 #include "Animation.h"
+#include "DealPool.h"
+#include "SolvabilityDB.h"
+#include "Replay.h"
+#include "BoardCache.h"
+#include "Layout.h"
+#include "LatencyMeter.h"
+#include "WinCascade.h"
+#include "Simulation.h"
+#include "HintService.h"
+#include "WinnabilityMonitor.h"
 
 struct DragState
 {
     bool dragging = false;
-    std::vector<Card> draggedCards;
+    CardStack draggedCards;
     int originPileIndex = -1;
     int originCardIndex = -1;
     int offsetX = 0, offsetY = 0;
@@ -25,11 +35,20 @@ struct DragState
 
 class GameEngine {
 public:
-    GameEngine(SDL_Renderer* ren, TTF_Font* f);
+    GameEngine(SDL_Renderer* ren, const StartupAssets& assets);
+    ~GameEngine();
     void update();
     void render();
     void handleEvent(SDL_Event& e);
     bool quit() const;
+    // Something on screen changed since the last render()
+    bool needsRender() const { return mNeedsRender; }
+    // Cards are in flight or being dragged: render at the display rate
+    bool isAnimating() const;
+    // Milliseconds until the screen changes without input (-1 = never)
+    int  msUntilUpdate() const;
+    // Called right after SDL_RenderPresent
+    void framePresented();
 
 private:
     void startNewGame();
@@ -37,21 +56,86 @@ private:
     void setupSettingsButtons();
     void setupStatisticsButtons();
     void setupPlayingButtons();
+    void setupReplayButtons();
 
-    void animateAutoMove(int srcPile,int cardIdx,int destPile,
-                         int sx,int sy,int dx,int dy);
+    // Sends a move to the rules thread and shows it until the reply arrives
+    void postMove(Move m);
+    // Rebuilds mView from the newest snapshot
+    void refreshView();
+    // The snapshot already shows the game startNewGame asked for
+    bool boardSynced() const;
+    void undoMove();
+    void redoMove();
+
+    // Flies the card from where it lies to the top of destPile
+    void animateAutoMove(int srcPile,int cardIdx,int destPile);
+    void onAnimationDone(const AnimEvent& ev);
     void checkWin();
-    bool findHint(int& hp,int& hc,int& dest);
+    // Nothing useful can be played any more: the game may be given up
+    bool gameDead() const;
+    void endGame();
+    void showHint();
+    // Shows the hint asked for once the search has answered
+    void pollHint();
+    DealRecord dealRecord() const;
+    bool pickWinnableSeed(uint64_t& seed);
     void autoComplete();
 
+    // mView laid out, brought up to date first
+    const BoardLayout& layout();
+    void renderBoard(const Game& g, const BoardLayout& layout);
+    void renderSettledBoard(const Game& g, BoardLayout& layout);
+    void renderDraggedStack();
+    void renderWinnability();
+#ifdef SOLITAIRE_PROFILE
+    void renderProfiler();
+#endif
+    uint32_t saveCurrentReplay();
+    void openLastReplay();
+    void loadLastReplay();
+
     SDL_Renderer* mRenderer;
     TTF_Font*     mFont;
+    const AssetBundle& mBundle; // card art is reloaded from it on a device reset
     CardRenderer  mCardRenderer;
+    BoardCache    mBoardCache;
+    WinCascade    mCascade;
     SoundManager  mSoundManager;
-    Game          mGame;
-    std::stack<Game> undoStack;
+    Simulation    mSim;
+    // What the board shows: the latest snapshot, plus moves the rules thread
+    // has not answered yet, minus cards in flight or being dragged
+    Game          mView;
+    std::array<SimCommand, 64> mPredicted;
+    int           mPredictedCount = 0;
+    std::array<uint8_t, PILE_COUNT> mInFlight{}; // cards lifted off each pile
+    uint32_t      mNewGameSeq = 0;
+    uint32_t      mReplaySaveSeq = 0; // SaveReplay to wait for before opening the replay
+    HintService   mHints;
+    bool          mHintWanted = false; // H pressed, answer not in yet
+    WinnabilityMonitor mWinnable;
+    Winnability   mWinnability = Winnability::Analyzing; // as last shown
+    Mode          mMode = RANDOM;
+    BoardLayout   mLayout;       // of mView
+    BoardLayout   mReplayLayout; // of mReplay.game()
+    AnimationTimeline mAnimations;
+    DealPool      mDealPool{1};
+    Difficulty    mDifficulty = Difficulty::Medium;
+    SolvabilityDB mSolvabilityDB;
+    DealRecord    mDealRecord;
+    ReplayPlayer  mReplay;
 
     bool           mQuit     = false;
+    bool           mNeedsRender = true;
+    Uint32         mShownSecond = 0; // HUD clock value last drawn
+    uint64_t       mDrawnHash = 0;   // board hash last drawn
+    // drag motion -> present latency; L toggles the readout
+    LatencyMeter   mDragLatency;
+    bool           mMotionPending = false;
+    Uint32         mMotionSince = 0; // oldest motion event not yet presented
+    bool           mShowLatency = false;
+#ifdef SOLITAIRE_PROFILE
+    bool           mShowProfiler = false;
+#endif
     bool           paused    = false;
     int            mDrawCount= 1;
     GameState      state     = MENU;
@@ -59,7 +143,8 @@ private:
     std::vector<Button> mMenuButtons,
                        mSettingsButtons,
                        mStatisticsButtons,
-                       mPlayingButtons;
+                       mPlayingButtons,
+                       mReplayButtons;
 
     Uint32 mStartTime=0;
     int    highScore=999999,
@@ -69,4 +154,5 @@ private:
     bool   hintActive=false, win=false;
     int    hintPileIndex=-1, hintCardIndex=-1;
     Uint32 hintStartTime=0;
+    std::string hintMessage;
 };
@@ -0,0 +1,53 @@
+// include/HintService.h
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include "Game.h"
+#include "Move.h"
+#include "PositionWorker.h"
+
+struct HintResult {
+    Move move{};
+    int  gain = 0;  // evaluation gained by the best line found
+    int  depth = 0; // plies searched to completely
+};
+
+// Best first move of the lines up to `maxDepth` plies deep, searched
+// deeper and deeper until `budgetMs` runs out or `cancel` is set. Moves
+// rankMove() rules out are never tried. False if there is no move worth
+// playing.
+bool searchHint(const Game& g, int drawCount, uint32_t budgetMs, HintResult& out,
+                int maxDepth = 6, const std::atomic<bool>* cancel = nullptr);
+
+// Runs searchHint on a worker thread and keeps the answers by position, so
+// asking for a hint never blocks the caller. The game requests each new
+// position while the player thinks; by the time the hint key is pressed
+// the answer is usually already cached.
+class HintService {
+public:
+    static constexpr int CACHE_SIZE = 256;
+
+    // `onReady` runs on the worker after each search, e.g. to wake an event loop
+    explicit HintService(uint32_t budgetMs, std::function<void()> onReady = nullptr);
+    HintService(const HintService&) = delete;
+    HintService& operator=(const HintService&) = delete;
+
+    // Searches `g` unless it is cached or already being searched; a search
+    // of any other position is abandoned
+    void request(const Game& g, int drawCount) { mWorker.request(g, drawCount); }
+    // The cached answer for `g`; false if not searched yet. `found` is false
+    // when the search found no move worth playing.
+    bool lookup(const Game& g, int drawCount, bool& found, HintResult& out);
+    void setBudget(uint32_t ms) { mBudgetMs = ms; }
+
+private:
+    struct Answer {
+        bool       found = false;
+        HintResult result;
+    };
+
+    std::atomic<uint32_t>   mBudgetMs;
+    PositionWorker<Answer, CACHE_SIZE> mWorker; // last: its thread uses the above
+};
@@ -0,0 +1,24 @@
+// include/LatencyMeter.h
+#pragma once
+
+#include <cstdint>
+
+// The last WINDOW latency samples, in milliseconds. Fixed storage, so
+// recording and querying never allocate.
+class LatencyMeter {
+public:
+    static constexpr int WINDOW = 256;
+
+    void add(uint32_t ms);
+    void clear() { mCount = mNext = 0; }
+
+    int      samples() const { return mCount; }
+    // q in [0,1]; 0 when there are no samples
+    uint32_t percentile(double q) const;
+    // Share of samples no longer than `ms`
+    double   within(uint32_t ms) const;
+
+private:
+    uint32_t mSamples[WINDOW];
+    int      mCount = 0, mNext = 0;
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include "Constants.h"
+
+struct Game;
+
+// Screen placement of the piles, kept out of the game state
+struct PileOrigin { int x, y; };
+
+// Top-left corner of pile slot `pileIndex` (index into Game::piles)
+PileOrigin pileOrigin(int pileIndex);
+
+// Where every card of a board is drawn, recomputed only when a pile
+// grows or shrinks, plus a uniform grid over the window that maps a
+// point to the piles that may be under it, for O(1) hit tests. Piles
+// never overlap each other, so a point hits at most one pile.
+class BoardLayout {
+public:
+    static constexpr int CELL       = 32;
+    static constexpr int GRID_W     = (WINDOW_WIDTH + CELL - 1) / CELL;
+    static constexpr int GRID_H     = (WINDOW_HEIGHT + CELL - 1) / CELL;
+    static constexpr int CELL_PILES = 2; // at most two piles meet in a cell
+
+    // Lays out `g` again if any pile changed size since the last call
+    void update(const Game& g);
+
+    // Top-left of card `card` of `pile`; card == the pile size gives the
+    // spot the next card added would take
+    PileOrigin cardPos(int pile, int card) const;
+    int        pileSize(int pile) const { return mSize[pile]; }
+    // Topmost card under (x,y). An empty pile's outline hits with card -1.
+    bool hitTest(int x, int y, int& pile, int& card) const;
+
+private:
+    void rebuild();
+
+    bool       mValid = false;
+    uint8_t    mSize[13] = {};
+    uint8_t    mStart[13 + 1] = {};  // first slot of each pile in mPos
+    PileOrigin mPos[52 + 13] = {};   // every card plus one free slot per pile
+    uint8_t    mCells[GRID_H][GRID_W][CELL_PILES] = {}; // pile + 1, 0 = none
+};
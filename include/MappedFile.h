@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+
+// Read-only memory map of a whole file. Pages are loaded by the OS on
+// first touch, so opening a large file costs neither time nor RSS.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const char* path);
+    void close();
+    bool isOpen() const { return mData != nullptr; }
+    const unsigned char* data() const { return mData; }
+    size_t size() const { return mSize; }
+
+private:
+    const unsigned char* mData = nullptr;
+    size_t               mSize = 0;
+#ifdef _WIN32
+    void*                mFile = nullptr;
+    void*                mMapping = nullptr;
+#endif
+};
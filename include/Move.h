@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+enum MoveKind : uint8_t { MOVE_DRAW, MOVE_RECYCLE, MOVE_CARDS };
+
+// Compact, reversible record of one player move (4 bytes)
+struct Move {
+    uint8_t kind    : 2; // MoveKind
+    uint8_t flipped : 1; // applying it turned the new top of `from` face up
+    uint8_t from;        // source pile slot
+    uint8_t to;          // destination pile slot
+    uint8_t count;       // cards moved, drawn or recycled
+};
+static_assert(sizeof(Move) == 4, "Move must stay four bytes");
+
+inline Move makeMove(MoveKind kind, int from, int to, int count) {
+    Move m{};
+    m.kind = kind; m.from = from; m.to = to; m.count = count;
+    return m;
+}
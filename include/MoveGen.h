@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Game.h"
+
+// Placement rules. Inline: the solver, hints and bots call these in their
+// innermost loops.
+inline bool isRedSuit(int suit) { return suit == 1 || suit == 2; } // hearts or diamonds
+
+// `c` may sit directly on `onto` in a tableau run
+inline bool canStackOn(Card c, Card onto) {
+    return isRedSuit(c.suit) != isRedSuit(onto.suit) && c.value + 1 == onto.value;
+}
+
+inline bool canPlaceOnTableau(const Card& c, const Pile& p) {
+    return p.cards.empty() ? c.value == 13 : canStackOn(c, p.cards.back());
+}
+
+inline bool canPlaceOnFoundation(const Card& c, const Pile& f) {
+    return f.cards.empty() ? c.value == 1
+                           : c.suit == f.cards.back().suit && c.value == f.cards.back().value + 1;
+}
+
+bool canMoveSequence(const CardStack& seq, const Pile& p);
+
+// First foundation `c` can go to, or -1
+int foundationFor(const Game& g, Card c);
+
+// Every move a position can have: each card has at most two tableau parents
+// and only kings use empty columns, so real positions stay far below this.
+constexpr int MAX_LEGAL_MOVES = 256;
+
+// Fixed-capacity move buffer; lives on the stack, never allocates
+struct MoveList {
+    Move moves[MAX_LEGAL_MOVES];
+    int  count = 0;
+
+    void clear() { count = 0; }
+    void add(Move m) { moves[count++] = m; }
+    bool empty() const { return count == 0; }
+    int  size() const { return count; }
+    const Move& operator[](int i) const { return moves[i]; }
+    const Move* begin() const { return moves; }
+    const Move* end() const { return moves + count; }
+};
+
+// Fills `out` with every legal move in `g`: foundation moves, waste and
+// foundation cards to the tableau, every movable tableau sub-stack, and the
+// stock click (draw or recycle) last.
+void generateMoves(const Game& g, int drawCount, MoveList& out);
+
+// Whether `m` is legal in `g`, by the same rules generateMoves uses
+bool isLegalMove(const Game& g, int drawCount, const Move& m);
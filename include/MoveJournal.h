@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "Move.h"
+
+// Undo/redo history as a flat list of applied moves plus a cursor.
+// Moves past the cursor are the redo tail; recording a new move drops it.
+class MoveJournal {
+public:
+    void record(const Move& m);
+    bool canUndo() const;
+    bool canRedo() const;
+    // Step the cursor and return the move to revert / re-apply
+    const Move& undo();
+    const Move& redo();
+    void clear();
+    size_t size() const;
+    // The moves currently applied, oldest first
+    const Move* begin() const { return mMoves.data(); }
+    const Move* end() const { return mMoves.data() + mCursor; }
+
+private:
+    std::vector<Move> mMoves;
+    size_t            mCursor = 0;
+};
@@ -0,0 +1,116 @@
+// include/PositionWorker.h
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include "Game.h"
+
+// Analyzes the latest position asked for on a worker thread and keeps the
+// answers by position. Only the newest request matters: asking for another
+// position sets the cancel flag handed to the analysis under way, and a
+// position already answered or under way is not queued again.
+//
+// `analyze(g, drawCount, cancel, out)` runs on the worker and returns false
+// when it stopped without an answer; nothing is cached then, and the
+// position is analyzed again if still asked for.
+template<class Result, int CacheSize>
+class PositionWorker {
+public:
+    using Analyze = std::function<bool(const Game&, int, const std::atomic<bool>&, Result&)>;
+
+    // `onReady` runs on the worker after each analysis, e.g. to wake an event loop.
+    // Starts the thread: declare it after whatever `analyze` uses.
+    PositionWorker(Analyze analyze, std::function<void()> onReady)
+        : mAnalyze(std::move(analyze)), mOnReady(std::move(onReady)) {
+        mThread = std::thread(&PositionWorker::run, this);
+    }
+    ~PositionWorker() {
+        {
+            std::lock_guard<std::mutex> lock(mLock);
+            mStopping = true;
+            mCancel = true;
+        }
+        mWake.notify_one();
+        mThread.join();
+    }
+    PositionWorker(const PositionWorker&) = delete;
+    PositionWorker& operator=(const PositionWorker&) = delete;
+
+    void request(const Game& g, int drawCount) {
+        uint64_t key = positionKey(g, drawCount);
+        {
+            std::lock_guard<std::mutex> lock(mLock);
+            if (mCache[key % CacheSize].key == key || mPendingKey == key) return;
+            mPending = g;
+            mPendingDraw = drawCount;
+            mPendingKey = key;
+            mQueued = true;
+            mCancel = true; // whatever is being analyzed is out of date
+        }
+        mWake.notify_one();
+    }
+    // False if `g` has no answer yet
+    bool lookup(const Game& g, int drawCount, Result& out) {
+        uint64_t key = positionKey(g, drawCount);
+        std::lock_guard<std::mutex> lock(mLock);
+        const Entry& e = mCache[key % CacheSize];
+        if (e.key != key) return false;
+        out = e.result;
+        return true;
+    }
+    // Records an answer found on the side, e.g. for a later position
+    void store(uint64_t key, const Result& r) {
+        std::lock_guard<std::mutex> lock(mLock);
+        mCache[key % CacheSize] = Entry{key, r};
+    }
+
+private:
+    struct Entry {
+        uint64_t key = 0; // 0 = empty
+        Result   result{};
+    };
+
+    void run() {
+        for (;;) {
+            Game g;
+            int draw;
+            uint64_t key;
+            {
+                std::unique_lock<std::mutex> lock(mLock);
+                mWake.wait(lock, [&] { return mStopping || mQueued; });
+                if (mStopping) return;
+                g = mPending;
+                draw = mPendingDraw;
+                key = mPendingKey;
+                mQueued = false;
+                mCancel = false;
+            }
+            Result r{};
+            bool answered = mAnalyze(g, draw, mCancel, r);
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                if (answered) mCache[key % CacheSize] = Entry{key, r};
+                if (mPendingKey == key) mPendingKey = 0;
+            }
+            if (mOnReady) mOnReady();
+        }
+    }
+
+    Analyze                 mAnalyze;
+    std::function<void()>   mOnReady;
+    std::mutex              mLock;
+    std::condition_variable mWake;
+    Entry                   mCache[CacheSize]; // direct-mapped by positionKey
+    Game                    mPending;
+    int                     mPendingDraw = 1;
+    uint64_t                mPendingKey = 0;   // queued or being analyzed
+    bool                    mQueued = false;
+    bool                    mStopping = false;
+    std::atomic<bool>       mCancel{false};
+    std::thread             mThread;
+};
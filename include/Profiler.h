@@ -0,0 +1,79 @@
+// include/Profiler.h
+#pragma once
+
+// Frame profiler, built only with -DSOLITAIRE_PROFILE (PROFILE=1 ./build.sh).
+// Without it every PROFILE_* macro expands to nothing and none of this
+// code exists in the binary.
+//   PROFILE_SCOPE("render");            times the rest of the enclosing block
+//   PROFILE_COUNT(PROFILE_DRAW_CALLS,n); adds to a counter of the current frame
+//   PROFILE_FRAME_BEGIN(); ... PROFILE_FRAME_END();  brackets one frame's work
+// Main thread only.
+
+#ifdef SOLITAIRE_PROFILE
+
+#include <cstdint>
+#include <vector>
+
+enum ProfileCounter { PROFILE_DRAW_CALLS, PROFILE_TEXTURE_UPLOADS, PROFILE_COUNTER_COUNT };
+
+class Profiler {
+public:
+    static constexpr int MAX_EVENTS   = 1 << 16; // scopes kept for the trace
+    static constexpr int MAX_FRAMES   = 1024;    // frames kept for the trace
+    static constexpr int STATS_FRAMES = 240;     // frames the overlay summarizes
+
+    static Profiler& instance();
+
+    uint64_t now() const; // nanoseconds since startup
+    void record(const char* name, uint64_t start, uint64_t end);
+    void count(ProfileCounter c, int n) { mCounters[c] += n; }
+    void beginFrame();
+    void endFrame();
+
+    // Over the last STATS_FRAMES frames; q in [0,1]
+    double frameMs(double q) const;
+    // Counter total of the last finished frame
+    int    lastFrameCount(ProfileCounter c) const;
+    // Chrome trace_event JSON, for chrome://tracing or ui.perfetto.dev
+    bool   writeChromeTrace(const char* path) const;
+
+private:
+    Profiler();
+    struct Event { const char* name; uint64_t start, end; };
+    struct Frame { uint64_t start, end; int counters[PROFILE_COUNTER_COUNT]; };
+
+    uint64_t           mEpoch;
+    std::vector<Event> mEvents;   // ring, MAX_EVENTS
+    std::vector<Frame> mFrames;   // ring, MAX_FRAMES
+    uint64_t           mEventCount = 0, mFrameCount = 0;
+    uint64_t           mFrameStart = 0;
+    int                mCounters[PROFILE_COUNTER_COUNT] = {};
+};
+
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name)
+        : mName(name), mStart(Profiler::instance().now()) {}
+    ~ProfileScope() { Profiler::instance().record(mName, mStart, Profiler::instance().now()); }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+private:
+    const char* mName;
+    uint64_t    mStart;
+};
+
+#define PROFILE_JOIN2(a, b) a##b
+#define PROFILE_JOIN(a, b)  PROFILE_JOIN2(a, b)
+#define PROFILE_SCOPE(name)        ProfileScope PROFILE_JOIN(profileScope, __LINE__)(name)
+#define PROFILE_COUNT(counter, n)  Profiler::instance().count(counter, n)
+#define PROFILE_FRAME_BEGIN()      Profiler::instance().beginFrame()
+#define PROFILE_FRAME_END()        Profiler::instance().endFrame()
+
+#else
+
+#define PROFILE_SCOPE(name)        ((void)0)
+#define PROFILE_COUNT(counter, n)  ((void)0)
+#define PROFILE_FRAME_BEGIN()      ((void)0)
+#define PROFILE_FRAME_END()        ((void)0)
+
+#endif
@@ -0,0 +1,25 @@
+// include/RenderBatch.h
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+// Textured quads from one texture, collected over a frame and submitted
+// with a single SDL_RenderGeometry call. Quads draw in the order added.
+class RenderBatch {
+public:
+    void begin(SDL_Texture* texture, int textureW, int textureH);
+    void add(const SDL_Rect& src, const SDL_Rect& dst);
+    // Submits and empties the batch; returns the number of draw calls used
+    int  flush(SDL_Renderer* renderer);
+    int  size() const { return int(mVertices.size() / 4); }
+
+private:
+    void clear();
+
+    SDL_Texture*            mTexture = nullptr;
+    float                   mInvW = 0, mInvH = 0;
+    std::vector<SDL_Vertex> mVertices; // kept between frames for capacity
+    std::vector<int>        mIndices;
+    std::vector<SDL_Rect>   mSrc, mDst; // for the per-quad fallback
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Game.h"
+#include "Move.h"
+
+// Moves between stored keyframes; seeking replays at most this many - 1
+constexpr int REPLAY_KEYFRAME_INTERVAL = 64;
+
+// A recorded game: the deal number plus every move played from the deal
+struct Replay {
+    uint64_t          seed = 0;
+    std::vector<Move> moves;
+};
+
+// Binary layout (all integers LEB128 varints):
+//   "SRPL" version(1 byte) seed interval moveCount
+//   moveCount moves: kind | count<<2 for stock moves (one byte),
+//   kind | from<<2 | to<<6 | count<<10 for card moves (two bytes)
+//   moveCount/interval keyframes, keyframe k being the board after
+//   k*interval moves: 13 x (cardCount, cards as Card bytes), zigzag score,
+//   moveCount
+// A typical game encodes in a few hundred bytes.
+std::vector<uint8_t> encodeReplay(const Replay& r, int keyframeInterval = REPLAY_KEYFRAME_INTERVAL);
+bool saveReplay(const char* path, const std::vector<uint8_t>& bytes);
+
+// Plays a decoded replay back. Seeking restores the nearest earlier
+// keyframe and re-applies the moves after it, so any position is at most
+// one keyframe interval of rules work away, and nothing is animated.
+class ReplayPlayer {
+public:
+    bool load(const uint8_t* data, size_t size);
+    bool load(const char* path);
+
+    uint64_t    seed() const { return mSeed; }
+    int         length() const { return int(mMoves.size()); }
+    int         position() const { return mPos; }
+    const Game& game() const { return mGame; }
+    const Move& move(int i) const { return mMoves[i]; }
+
+    // False if a recorded move turns out illegal; the board stops before it
+    bool seek(int moveIndex);
+    bool step(int delta) { return seek(mPos + delta); }
+
+private:
+    uint64_t          mSeed = 0;
+    int               mInterval = REPLAY_KEYFRAME_INTERVAL;
+    std::vector<Move> mMoves;
+    std::vector<Game> mKeyframes; // [0] is the deal itself
+    Game              mGame;
+    int               mPos = 0;
+};
@@ -0,0 +1,82 @@
+// include/Simulation.h
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "Game.h"
+#include "Move.h"
+#include "MoveJournal.h"
+#include "SpscQueue.h"
+#include "StallDetector.h"
+#include "TripleBuffer.h"
+
+enum class SimCommandKind : uint8_t { NewGame, Move, Undo, Redo, SaveReplay };
+
+struct SimCommand {
+    SimCommandKind kind = SimCommandKind::Move;
+    uint8_t  drawCount = 1; // Move: the setting the move was made under
+    Mode     mode = RANDOM; // NewGame
+    Move     move{};        // Move
+    uint64_t seed = 0;      // NewGame
+    uint32_t seq = 0;       // filled in by post()
+};
+
+// Everything the render side may look at, copied whole on every step
+struct SimSnapshot {
+    Game     game;
+    uint32_t ackSeq = 0; // last command handled, applied or rejected
+    bool     won = false;
+    bool     dead = false; // probably stuck (see StallDetector)
+};
+
+// The rules thread. Owns the Game, its undo journal and the replay saving;
+// the main thread only posts commands and reads published snapshots, so a
+// slow frame never holds up a rules step and the reverse. Sleeps while no
+// commands are queued and otherwise steps at most TICK_HZ times a second,
+// each step handling every command queued so far.
+class Simulation {
+public:
+    static constexpr int TICK_HZ = 120;
+    static constexpr size_t QUEUE_SIZE = 256;
+
+    // `onPublish` runs on the rules thread after each new snapshot, e.g. to
+    // wake an event loop that is waiting for input
+    explicit Simulation(std::function<void()> onPublish = nullptr);
+    ~Simulation();
+    Simulation(const Simulation&) = delete;
+    Simulation& operator=(const Simulation&) = delete;
+
+    // Main thread. Returns the command's sequence number, 0 if the queue is full.
+    uint32_t post(SimCommand c);
+    // Main thread: newest snapshot published; true if it changed since the last call
+    bool refresh() { return mSnapshots.refresh(); }
+    const SimSnapshot& snapshot() const { return mSnapshots.front(); }
+    // Handles what is queued, saves the replay and joins the thread
+    void stop();
+
+private:
+    void run();
+    void apply(const SimCommand& c);
+    void publish();
+    void saveReplay();
+
+    SpscQueue<SimCommand, QUEUE_SIZE> mCommands;
+    TripleBuffer<SimSnapshot>        mSnapshots;
+    std::mutex              mWakeLock;
+    std::condition_variable mWake;
+    std::atomic<bool>       mStopping{false};
+    std::function<void()>   mOnPublish;
+    uint32_t                mNextSeq = 1; // main thread
+    std::thread             mThread;
+
+    // rules thread only
+    Game        mGame;
+    MoveJournal mJournal;
+    StallDetector mStall;
+    uint32_t    mAckSeq = 0;
+    bool        mReplaySaved = true; // current game already on disk
+};
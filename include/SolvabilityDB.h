@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "DealGenerator.h"
+#include "MappedFile.h"
+
+enum class DealStatus : uint8_t { Unknown, Winnable, Unwinnable };
+
+// What the offline solver learned about one deal number
+struct DealRecord {
+    DealStatus status = DealStatus::Unknown;
+    Difficulty difficulty = Difficulty::Easy;
+    int        moves = 0; // length of the first winning line found, not the shortest (0 if none)
+};
+
+// On-disk layout, little-endian on every host (big-endian ones swap each
+// field as they read or write it), read in place through a memory map:
+//   header  (32 bytes, below)
+//   records (count x uint16: bits 0-1 status, 2-3 difficulty, 4-15 moves)
+// Record i describes deal number firstSeed + i.
+struct SolvabilityHeader {
+    char     magic[8];  // "SOLVDB\0\1"
+    uint32_t drawCount;
+    uint32_t reserved;
+    uint64_t firstSeed;
+    uint64_t count;
+};
+static_assert(sizeof(SolvabilityHeader) == 32, "header layout is part of the file format");
+
+constexpr int MAX_RECORD_MOVES = 4095;
+
+uint16_t   packDealRecord(const DealRecord& r);
+DealRecord unpackDealRecord(uint16_t bits);
+
+bool writeSolvabilityDB(const char* path,int drawCount,uint64_t firstSeed,
+                        const std::vector<uint16_t>& records);
+
+// O(1) lookups straight out of the mapped file; nothing is parsed or copied
+class SolvabilityDB {
+public:
+    bool open(const char* path);
+    void close();
+    bool isOpen() const { return mRecords != nullptr; }
+
+    // False when the seed is outside the covered range
+    bool lookup(uint64_t seed,DealRecord& out) const;
+    int      drawCount() const { return mDrawCount; }
+    uint64_t firstSeed() const { return mFirstSeed; }
+    uint64_t count()     const { return mCount; }
+
+private:
+    MappedFile      mFile;
+    const uint16_t* mRecords = nullptr;
+    // header fields in host byte order
+    int             mDrawCount = 0;
+    uint64_t        mFirstSeed = 0, mCount = 0;
+};
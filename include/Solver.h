@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "Game.h"
+#include "Move.h"
+#include "TranspositionTable.h"
+
+enum class SolveStatus { Solved, Unsolvable, Unknown };
+
+// Search budget; whichever runs out first ends the search as Unknown
+struct SolverLimits {
+    uint64_t maxNodes  = 2000000;
+    uint32_t maxMillis = 2000;
+    // Set from another thread to stop; unlike cancel() it is never reset
+    // by the solver, so it can be raised before the search starts
+    const std::atomic<bool>* stop = nullptr;
+};
+
+// Per-thread counters from a parallel solve
+struct ThreadStats {
+    uint64_t nodes       = 0;
+    uint64_t tasks       = 0; // subtrees searched
+    uint64_t steals      = 0; // of those, taken from another thread
+    double   seconds     = 0; // wall time the thread ran
+    double   busySeconds = 0; // time spent searching rather than looking for work
+    double   nodesPerSecond() const;
+};
+
+struct SolveResult {
+    SolveStatus              status = SolveStatus::Unknown;
+    std::vector<Move>        moves;    // winning line from the given position
+    uint64_t                 nodes = 0;
+    std::vector<ThreadStats> threads;  // filled by ParallelSolver
+};
+
+// Headless Klondike solver: depth-first search over reversible moves with
+// a hashed transposition table. Exhausting the tree proves a deal lost.
+class Solver {
+public:
+    explicit Solver(int ttBits = 20);
+    SolveResult solve(const Game& game,int drawCount,const SolverLimits& limits = {});
+    // Ask a running solve() on another thread to stop; it returns Unknown
+    void cancel();
+
+private:
+    TranspositionTable mTable;
+    std::atomic<bool>  mCancel{false};
+};
+
+// The same search split across threads. Idle threads steal untried
+// subtrees from busy ones, all threads share one lock-free transposition
+// table, and the first solution found stops every thread.
+class ParallelSolver {
+public:
+    // threads <= 0 uses every hardware thread
+    explicit ParallelSolver(int threads = 0,int ttBits = 22);
+    SolveResult solve(const Game& game,int drawCount,const SolverLimits& limits = {});
+    // Ask a running solve() on another thread to stop; it returns Unknown
+    void cancel();
+    int threadCount() const;
+
+private:
+    int                mThreads;
+    TranspositionTable mTable;
+    std::atomic<bool>  mCancel{false};
+};
+
+// True when every card is on a foundation
+bool isSolved(const Game& game);
@@ -1,11 +1,13 @@
 // include/SoundManager.h
 #pragma once
 #include <SDL2/SDL_mixer.h>
+#include <cstddef>
 
 // Plays move‐sound, toggles on/off
 class SoundManager {
 public:
-    SoundManager();
+    // The move sound comes from `wav` when given, else MOVE_SOUND_FILE
+    explicit SoundManager(const unsigned char* wav = nullptr, size_t size = 0);
     ~SoundManager();
     void playMoveSound();
     void toggleSound();
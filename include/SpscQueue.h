@@ -0,0 +1,40 @@
+// include/SpscQueue.h
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// Bounded FIFO for exactly one producer and one consumer thread. Fixed
+// storage; push and pop are a couple of atomic loads and one store.
+template<class T, size_t N>
+class SpscQueue {
+    static_assert((N & (N - 1)) == 0, "capacity must be a power of two");
+
+public:
+    // False when full
+    bool push(const T& v) {
+        size_t head = mHead.load(std::memory_order_relaxed);
+        if (head - mTail.load(std::memory_order_acquire) == N)
+            return false;
+        mSlots[head & (N - 1)] = v;
+        mHead.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    // False when empty
+    bool pop(T& v) {
+        size_t tail = mTail.load(std::memory_order_relaxed);
+        if (tail == mHead.load(std::memory_order_acquire))
+            return false;
+        v = mSlots[tail & (N - 1)];
+        mTail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    bool empty() const {
+        return mTail.load(std::memory_order_acquire) == mHead.load(std::memory_order_acquire);
+    }
+
+private:
+    alignas(64) std::atomic<size_t> mHead{0}; // producer writes
+    alignas(64) std::atomic<size_t> mTail{0}; // consumer writes
+    T mSlots[N];
+};
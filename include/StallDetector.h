@@ -0,0 +1,32 @@
+// include/StallDetector.h
+#pragma once
+
+#include <cstdint>
+#include "Game.h"
+#include "Move.h"
+
+// Notices a game going round the stock without getting anywhere. Fed every
+// move as it is played, at constant cost per move: a draw checks the one
+// card it turned up, and a recycle compares the position hash with the one
+// the previous recycle left and scans the board once for useful moves.
+class StallDetector {
+public:
+    void reset() { *this = StallDetector(); }
+    // After `m` has been applied to `g`
+    void onMove(const Game& g, int drawCount, const Move& m);
+
+    // The last full pass through the stock ended in the same position as
+    // the pass before it: playing on the same way repeats forever
+    bool cycling() const { return mCycling; }
+    // ...and that pass never offered a useful move (a waste card to play, a
+    // card to send home, a card to turn over, a run to shift off a card that
+    // could then go home): the game is probably stuck. A heuristic, not a
+    // proof; longer plans can still get through.
+    bool dead() const { return mDead; }
+
+private:
+    uint64_t mPassStart = 0;      // hash after the last recycle; 0 = none yet
+    int      mPlayable = 0;       // drawn cards this pass that had somewhere to go
+    bool     mBoardMoves = false; // a useful tableau move existed as the pass began
+    bool     mCycling = false, mDead = false;
+};
@@ -0,0 +1,46 @@
+// include/TextCache.h
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+// Rendered strings keyed by text and colour. A string is rasterized and
+// uploaded the first time it is drawn; after that drawing it is a single
+// SDL_RenderCopy. The least recently drawn string is evicted when full.
+class TextCache {
+public:
+    TextCache(SDL_Renderer* renderer, TTF_Font* font, size_t capacity = 96);
+    ~TextCache();
+    TextCache(const TextCache&) = delete;
+    TextCache& operator=(const TextCache&) = delete;
+
+    void draw(const std::string& text, int x, int y, SDL_Color color = {255, 255, 255, 255});
+    // Centred in `box`
+    void drawCentered(const std::string& text, const SDL_Rect& box, SDL_Color color);
+    // Drops every texture, e.g. after SDL_RENDER_DEVICE_RESET
+    void clear();
+
+    uint64_t hits() const { return mHits; }
+    uint64_t misses() const { return mMisses; }
+    size_t   size() const { return mIndex.size(); }
+
+private:
+    struct Entry {
+        std::string  key;
+        SDL_Texture* texture;
+        int          w, h;
+    };
+    const Entry* lookup(const std::string& text, SDL_Color color);
+
+    SDL_Renderer*     mRenderer;
+    TTF_Font*         mFont;
+    size_t            mCapacity;
+    std::list<Entry>  mEntries; // most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> mIndex;
+    std::string       mKey; // reused so a hit never allocates
+    uint64_t          mHits = 0, mMisses = 0;
+};
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Set of visited position hashes for the solver, safe to share between
+// search threads without locks. Open addressing with a short linear probe;
+// slots are claimed with a CAS, and when a probe window is full the home
+// slot is overwritten, which only costs a re-search later.
+class TranspositionTable {
+public:
+    explicit TranspositionTable(int bits = 20);
+    // True if `hash` was not present (and is now recorded)
+    bool insert(uint64_t hash);
+    void clear();
+    size_t capacity() const;
+
+private:
+    std::unique_ptr<std::atomic<uint64_t>[]> mSlots;
+    uint64_t                                 mMask;
+};
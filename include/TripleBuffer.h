@@ -0,0 +1,34 @@
+// include/TripleBuffer.h
+#pragma once
+
+#include <atomic>
+
+// Latest-value handoff between one writer and one reader thread. The writer
+// fills back() and publishes it; the reader picks up the newest published
+// value with refresh(). Neither side ever waits for the other, and a value
+// the reader has not picked up yet is simply overwritten.
+template<class T>
+class TripleBuffer {
+public:
+    // Writer: the slot to fill. Holds stale data; write all of it.
+    T&   back() { return mSlots[mBack].value; }
+    void publish() { mBack = mShared.exchange(mBack | FRESH, std::memory_order_acq_rel) & INDEX; }
+
+    // Reader: swaps in the newest published value; false if there is none
+    bool refresh() {
+        if (!(mShared.load(std::memory_order_relaxed) & FRESH))
+            return false;
+        mFront = mShared.exchange(mFront, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+    const T& front() const { return mSlots[mFront].value; }
+
+private:
+    static constexpr unsigned INDEX = 3, FRESH = 4;
+    struct alignas(64) Slot { T value{}; };
+
+    Slot                  mSlots[3];
+    std::atomic<unsigned> mShared{1}; // slot between the two, plus FRESH
+    alignas(64) unsigned  mBack = 0;  // writer only
+    alignas(64) unsigned  mFront = 2; // reader only
+};
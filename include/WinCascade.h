@@ -0,0 +1,63 @@
+// include/WinCascade.h
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <array>
+#include <cstdint>
+#include <random>
+#include "Game.h"
+
+class CardRenderer;
+
+// The bouncing-card win animation. Foundation cards are launched one
+// after another, fall under gravity, bounce off the bottom of the window
+// and leave a trail until they leave it sideways. Card state is kept as
+// one array per field. Each physics step stamps the flying cards once into
+// a retained render target, so a frame costs one copy of the trails plus
+// one batch of new stamps however long the trails have grown.
+class WinCascade {
+public:
+    static constexpr int MAX_CARDS = 52;
+    static constexpr int STEP_HZ   = 120; // physics steps (and stamps) per second
+
+    explicit WinCascade(SDL_Renderer* renderer);
+    ~WinCascade();
+    WinCascade(const WinCascade&) = delete;
+    WinCascade& operator=(const WinCascade&) = delete;
+
+    // Queues the foundation cards of `g`, kings first
+    void start(const Game& g, uint64_t seed, Uint32 now);
+    // Drops the cards and the trails
+    void stop();
+    // Render targets lose their contents on SDL_RENDER_TARGETS_RESET
+    void resetTrails() { mClearTrails = true; }
+
+    // Cards still flying or waiting to launch
+    bool running() const { return mActive && (mLive > 0 || mLaunched < mQueued); }
+    bool visible() const { return mActive; }
+    // Advances the simulation to `now`, stamps the new trail segments and
+    // draws the trails with the cards in flight on top
+    void render(Uint32 now, CardRenderer& cards);
+
+private:
+    void launch();
+    void step(float dt);
+
+    SDL_Renderer* mRenderer;
+    SDL_Texture*  mTrails = nullptr; // null: no render targets, no trails
+    bool          mClearTrails = true;
+    bool          mActive = false;
+    std::mt19937  mRng;
+
+    // launch queue
+    std::array<Card, MAX_CARDS> mQueue;
+    std::array<int, MAX_CARDS>  mQueuePile;
+    int    mQueued = 0, mLaunched = 0;
+    Uint32 mStart = 0;
+    Uint32 mSimulatedMs = 0; // simulation time reached, from mStart
+
+    // cards in flight
+    std::array<float, MAX_CARDS> mX, mY, mVX, mVY;
+    std::array<Card, MAX_CARDS>  mCard;
+    int mLive = 0;
+};
@@ -0,0 +1,47 @@
+// include/WinnabilityMonitor.h
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include "Game.h"
+#include "PositionWorker.h"
+#include "Solver.h"
+
+// Analyzing: not answered yet. Unknown: the budget ran out first.
+enum class Winnability : uint8_t { Analyzing, Winnable, Lost, Unknown };
+
+// Keeps asking the solver whether the position on the board can still be
+// won, one bounded solve at a time on a worker thread. The face-down cards
+// count as known, as in the solvability database.
+//
+// Answers carry over between positions: every position along a winning
+// line is recorded as winnable, and anything one move on from a lost
+// position is lost without searching.
+class WinnabilityMonitor {
+public:
+    static constexpr int CACHE_SIZE = 4096;
+
+    // `onReady` runs on the worker after each answer, e.g. to wake an event loop
+    explicit WinnabilityMonitor(const SolverLimits& limits, std::function<void()> onReady = nullptr);
+    WinnabilityMonitor(const WinnabilityMonitor&) = delete;
+    WinnabilityMonitor& operator=(const WinnabilityMonitor&) = delete;
+
+    // Analyzes `g` unless already answered or under way; a solve of any
+    // other position is stopped at once
+    void request(const Game& g, int drawCount) { mWorker.request(g, drawCount); }
+    Winnability status(const Game& g, int drawCount);
+
+private:
+    // False when stopped before an answer
+    bool analyze(const Game& g, int drawCount, const std::atomic<bool>& stop, Winnability& out);
+
+    SolverLimits            mLimits;
+
+    // worker only
+    Solver                  mSolver;
+    Game                    mLost;      // last position proven lost
+    int                     mLostDraw = 0; // 0 = none
+
+    PositionWorker<Winnability, CACHE_SIZE> mWorker; // last: its thread uses the above
+};
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+#include "Card.h"
+
+// Zobrist key for card `c` sitting at `depth` in pile `pile`.
+// Keys are derived with a splitmix64 finalizer instead of a lookup table,
+// so hashing never touches memory outside the board itself.
+inline uint64_t zobristKey(Card c, int pile, int depth) {
+    uint64_t z = (uint64_t(cardId(c)) << 16 | uint64_t(pile) << 8 | uint64_t(depth) << 1 | c.faceUp)
+               + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
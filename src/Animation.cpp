@@ -3,28 +3,42 @@
 #include "../include/Utility.h"
 #include "../include/CardRenderer.h"
 #include "../include/Constants.h"
-#include <SDL2/SDL.h>
+#include "../include/Profiler.h"
 
-std::vector<Animation> animations;
+AnimationTimeline::AnimationTimeline():mPool(CAPACITY),mEvents(CAPACITY){}
 
-void animateCardMove(const Card& c,int fx,int fy,int tx,int ty,Uint32 ms,std::function<void()> cb){
-  animations.push_back(Animation{AnimType::MoveCard,c,fx,fy,tx,ty,SDL_GetTicks(),ms,cb});
+bool AnimationTimeline::add(const Animation& a){
+  if(mCount==CAPACITY) return false;
+  mPool[mCount++]=a;
+  return true;
 }
 
-void updateAnimations(CardRenderer& R){
-  Uint32 now=SDL_GetTicks();
-  for(size_t i=0;i<animations.size();){
-    auto& A=animations[i];
-    float t=float(now-A.startTime)/float(A.duration);
+bool AnimationTimeline::moveCard(const Card& c,int fx,int fy,int tx,int ty,Uint32 ms,
+                                 AnimDone done,Move move,Uint32 delay){
+  return add(Animation{c,done,move,fx,fy,tx,ty,SDL_GetTicks()+delay,ms});
+}
+
+int AnimationTimeline::advance(Uint32 now){
+  PROFILE_SCOPE("AnimationTimeline::advance");
+  int n=0;
+  for(int i=0;i<mCount;){
+    const Animation& A=mPool[i];
+    // signed, so an animation that has not started yet is not finished
+    if(int32_t(now-A.startTime)<int32_t(A.duration)){ ++i; continue; }
+    mEvents[n++]=AnimEvent{A.done,A.card,A.move};
+    mPool[i]=mPool[--mCount];
+  }
+  return n;
+}
+
+void AnimationTimeline::draw(Uint32 now,CardRenderer& R) const {
+  PROFILE_SCOPE("AnimationTimeline::draw");
+  for(int i=0;i<mCount;++i){
+    const Animation& A=mPool[i];
+    int32_t elapsed=int32_t(now-A.startTime);
+    float t=elapsed<=0 ? 0.f : float(elapsed)/float(A.duration);
     if(t>1.f) t=1.f;
     float e=easeOutQuad(t);
-    if(A.type==AnimType::MoveCard){
-      int x=lerp(A.srcX,A.dstX,e), y=lerp(A.srcY,A.dstY,e);
-      R.drawCard(x,y,A.card);
-    }
-    if(t>=1.f){
-      if(A.onComplete) A.onComplete();
-      animations.erase(animations.begin()+i);
-    } else ++i;
+    R.drawCard(lerp(A.srcX,A.dstX,e),lerp(A.srcY,A.dstY,e),A.card);
   }
 }
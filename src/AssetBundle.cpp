@@ -0,0 +1,79 @@
+// src/AssetBundle.cpp
+#include "../include/AssetBundle.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+static const char     BUNDLE_MAGIC[4]={'S','A','B','1'};
+static const uint32_t BUNDLE_VERSION=1;
+static const uint64_t BUNDLE_ALIGN=64;
+
+static uint64_t alignUp(uint64_t v){ return (v+BUNDLE_ALIGN-1)&~(BUNDLE_ALIGN-1); }
+
+bool writeAssetBundle(const char* path,const std::vector<AssetSource>& assets){
+  AssetBundleHeader h{};
+  std::memcpy(h.magic,BUNDLE_MAGIC,4);
+  h.version=BUNDLE_VERSION;
+  h.count=uint32_t(assets.size());
+  std::vector<AssetEntry> entries(assets.size());
+  uint64_t at=alignUp(sizeof h+entries.size()*sizeof(AssetEntry));
+  for(size_t i=0;i<assets.size();++i){
+    const AssetSource& a=assets[i];
+    if(a.name.size()>=sizeof entries[i].name) return false;
+    std::memcpy(entries[i].name,a.name.c_str(),a.name.size()+1);
+    entries[i].kind=a.kind;
+    entries[i].width=uint32_t(a.width);
+    entries[i].height=uint32_t(a.height);
+    entries[i].offset=at;
+    entries[i].size=a.bytes.size();
+    at=alignUp(at+a.bytes.size());
+  }
+  // payloads go in place behind the table, gaps left zero
+  std::vector<unsigned char> file(at);
+  std::memcpy(file.data(),&h,sizeof h);
+  if(!entries.empty()) std::memcpy(file.data()+sizeof h,entries.data(),entries.size()*sizeof(AssetEntry));
+  for(size_t i=0;i<assets.size();++i)
+    std::copy(assets[i].bytes.begin(),assets[i].bytes.end(),file.begin()+long(entries[i].offset));
+  FILE* f=std::fopen(path,"wb");
+  if(!f) return false;
+  bool ok=std::fwrite(file.data(),1,file.size(),f)==file.size();
+  return std::fclose(f)==0 && ok;
+}
+
+bool AssetBundle::open(const char* path){
+  close();
+  return mFile.open(path) && open(mFile.data(),mFile.size());
+}
+
+bool AssetBundle::open(const unsigned char* data,size_t size){
+  mEntries=nullptr;
+  auto* h=reinterpret_cast<const AssetBundleHeader*>(data);
+  if(size<sizeof *h || std::memcmp(h->magic,BUNDLE_MAGIC,4)!=0 || h->version!=BUNDLE_VERSION ||
+     (size-sizeof *h)/sizeof(AssetEntry)<h->count)
+    return false;
+  auto* e=reinterpret_cast<const AssetEntry*>(data+sizeof *h);
+  for(uint32_t i=0;i<h->count;++i)
+    if(e[i].offset>size || e[i].size>size-e[i].offset || e[i].name[sizeof e[i].name-1]!='\0' ||
+       (e[i].kind==ASSET_RGBA && uint64_t(e[i].width)*e[i].height*4!=e[i].size))
+      return false;
+  mData=data;
+  mSize=size;
+  mEntries=e;
+  mCount=h->count;
+  return true;
+}
+
+void AssetBundle::close(){
+  mFile.close();
+  mData=nullptr; mSize=0; mEntries=nullptr; mCount=0;
+}
+
+bool AssetBundle::find(const char* name,AssetView& out) const {
+  for(uint32_t i=0;i<mCount;++i){
+    const AssetEntry& e=mEntries[i];
+    if(std::strcmp(e.name,name)!=0) continue;
+    out=AssetView{AssetKind(e.kind),int(e.width),int(e.height),mData+e.offset,size_t(e.size)};
+    return true;
+  }
+  return false;
+}
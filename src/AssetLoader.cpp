@@ -0,0 +1,88 @@
+// src/AssetLoader.cpp
+#include "../include/AssetLoader.h"
+#include "../include/Constants.h"
+#include <SDL2/SDL_image.h>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef SOLITAIRE_EMBED_ASSETS
+// from `ld -r -b binary assets.sab` (EMBED_ASSETS=1 ./build.sh)
+extern "C" const unsigned char _binary_assets_sab_start[];
+extern "C" const unsigned char _binary_assets_sab_end[];
+#endif
+
+const char* const TEXTURE_FILES[TEXTURE_COUNT]={
+  SPADE_IMG,HEART_IMG,DIAMOND_IMG,CLUB_IMG,CARDBACK_IMG,JACK_IMG,QUEEN_IMG,KING_IMG
+};
+
+namespace {
+
+bool openBundle(AssetBundle& b){
+#ifdef SOLITAIRE_EMBED_ASSETS
+  if(b.open(_binary_assets_sab_start,size_t(_binary_assets_sab_end-_binary_assets_sab_start))) return true;
+#endif
+  return b.open(ASSET_BUNDLE_FILE);
+}
+
+SDL_Texture* textureFromPixels(SDL_Renderer* R,const AssetView& v){
+  SDL_Texture* t=SDL_CreateTexture(R,SDL_PIXELFORMAT_RGBA32,SDL_TEXTUREACCESS_STATIC,v.width,v.height);
+  if(!t) return nullptr;
+  SDL_UpdateTexture(t,nullptr,v.data,v.width*4);
+  SDL_SetTextureBlendMode(t,SDL_BLENDMODE_BLEND);
+  return t;
+}
+
+// Fills the empty slots of `out` from the loose PNGs: one decode per
+// worker, textures created here afterwards. The font, if asked for, loads
+// meanwhile.
+void loadLooseTextures(SDL_Renderer* R,SDL_Texture* out[TEXTURE_COUNT],TTF_Font** font){
+  SDL_Surface* surfaces[TEXTURE_COUNT]={};
+  // SDL keeps the error string per thread, so a failed decode copies its own
+  std::string errors[TEXTURE_COUNT];
+  std::vector<std::thread> workers;
+  for(int i=0;i<TEXTURE_COUNT;++i)
+    if(!out[i]) workers.emplace_back([&surfaces,&errors,i]{
+      surfaces[i]=IMG_Load(TEXTURE_FILES[i]);
+      if(!surfaces[i]) errors[i]=IMG_GetError();
+    });
+  if(font && !*font) *font=TTF_OpenFont(FONT_FILE,FONT_SIZE);
+  for(auto& w:workers) w.join();
+  for(int i=0;i<TEXTURE_COUNT;++i){
+    if(out[i]) continue;
+    if(!surfaces[i]){ std::cerr<<"Texture error ("<<TEXTURE_FILES[i]<<"): "<<errors[i]<<"\n"; continue; }
+    out[i]=SDL_CreateTextureFromSurface(R,surfaces[i]);
+    SDL_FreeSurface(surfaces[i]);
+  }
+}
+
+void loadBundledTextures(SDL_Renderer* R,const AssetBundle& bundle,SDL_Texture* out[TEXTURE_COUNT]){
+  AssetView v;
+  for(int i=0;i<TEXTURE_COUNT;++i)
+    if(bundle.isOpen() && bundle.find(TEXTURE_FILES[i],v) && v.kind==ASSET_RGBA) out[i]=textureFromPixels(R,v);
+}
+
+} // namespace
+
+void loadCardTextures(SDL_Renderer* R,const AssetBundle& bundle,SDL_Texture* out[TEXTURE_COUNT]){
+  loadBundledTextures(R,bundle,out);
+  loadLooseTextures(R,out,nullptr);
+}
+
+bool loadStartupAssets(SDL_Renderer* R,StartupAssets& out){
+  if(openBundle(out.bundle)){
+    AssetView v;
+    loadBundledTextures(R,out.bundle,out.textures);
+    if(out.bundle.find(FONT_FILE,v))
+      out.font=TTF_OpenFontRW(SDL_RWFromConstMem(v.data,int(v.size)),1,FONT_SIZE);
+    if(out.bundle.find(MOVE_SOUND_FILE,v)){
+      out.moveSound=v.data;
+      out.moveSoundSize=v.size;
+    }
+  }
+  // a stale or partial bundle still works; the rest comes from loose files
+  loadLooseTextures(R,out.textures,&out.font);
+  if(!out.font) std::cerr<<"OpenFont: "<<TTF_GetError()<<"\n";
+  return out.font!=nullptr;
+}
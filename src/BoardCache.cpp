@@ -0,0 +1,70 @@
+// src/BoardCache.cpp
+#include "../include/BoardCache.h"
+#include "../include/CardRenderer.h"
+#include "../include/Constants.h"
+#include "../include/Layout.h"
+#include "../include/Profiler.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+bool sameCards(const CardStack& a,const CardStack& b){
+  return a.size()==b.size() && std::memcmp(a.data,b.data,a.size())==0;
+}
+
+// Screen area a pile can cover; tableau columns never overlap, so each
+// pile owns its region outright
+SDL_Rect pileRegion(int p){
+  PileOrigin o=pileOrigin(p);
+  if(p>=FIRST_TABLEAU) return {o.x,o.y,CARD_WIDTH,WINDOW_HEIGHT-o.y};
+  return {o.x,o.y,CARD_WIDTH,CARD_HEIGHT};
+}
+} // namespace
+
+BoardCache::BoardCache(SDL_Renderer* R):mRenderer(R){
+  if(SDL_RenderTargetSupported(R))
+    mTexture=SDL_CreateTexture(R,SDL_PIXELFORMAT_RGBA8888,SDL_TEXTUREACCESS_TARGET,
+                               WINDOW_WIDTH,WINDOW_HEIGHT);
+}
+
+BoardCache::~BoardCache(){ if(mTexture) SDL_DestroyTexture(mTexture); }
+
+int BoardCache::update(const Game& g,const BoardLayout& L,CardRenderer& cards){
+  int dirty[PILE_COUNT], n=0;
+  for(int p=0;p<PILE_COUNT;++p)
+    if(mAllDirty || !sameCards(g.piles[p].cards,mDrawn[p])) dirty[n++]=p;
+  if(n==0) return 0;
+
+  PROFILE_SCOPE("BoardCache::update");
+  SDL_Texture* previous=SDL_GetRenderTarget(mRenderer);
+  SDL_SetRenderTarget(mRenderer,mTexture);
+  SDL_SetRenderDrawColor(mRenderer,TABLE_COLOR_R,TABLE_COLOR_G,TABLE_COLOR_B,255);
+  if(mAllDirty) SDL_RenderClear(mRenderer);
+  SDL_Rect regions[PILE_COUNT], outlines[PILE_COUNT];
+  for(int i=0;i<n;++i){
+    regions[i]=pileRegion(dirty[i]);
+    outlines[i]=SDL_Rect{regions[i].x,regions[i].y,CARD_WIDTH,CARD_HEIGHT};
+  }
+  SDL_RenderFillRects(mRenderer,regions,n);
+  SDL_SetRenderDrawColor(mRenderer,50,50,50,255);
+  SDL_RenderDrawRects(mRenderer,outlines,n);
+  cards.beginBatch();
+  for(int i=0;i<n;++i){
+    int p=dirty[i];
+    const CardStack& cs=g.piles[p].cards;
+    for(int c=0;c<(int)cs.size();++c){
+      PileOrigin at=L.cardPos(p,c);
+      cards.drawCard(at.x,at.y,cs[c]);
+    }
+    mDrawn[p]=cs;
+  }
+  cards.flushBatch();
+  SDL_SetRenderTarget(mRenderer,previous);
+  mAllDirty=false;
+  return n;
+}
+
+void BoardCache::draw(){
+  SDL_RenderCopy(mRenderer,mTexture,nullptr,nullptr);
+  PROFILE_COUNT(PROFILE_DRAW_CALLS,1);
+}
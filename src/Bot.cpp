@@ -0,0 +1,100 @@
+// src/Bot.cpp
+#include "../include/Bot.h"
+#include "../include/StallDetector.h"
+#include <cstring>
+
+int rankMove(const Game& g,const Move& m){
+  if(m.kind!=MOVE_CARDS) return 1;
+  if(g.piles[m.to].type==FOUNDATION) return 4;
+  if(m.from==WASTE_PILE) return 2;
+  // shuffling part of a run or backing a card off a foundation only
+  // undoes progress
+  if(g.piles[m.from].type!=TABLEAU) return -1;
+  const CardStack& src=g.piles[m.from].cards;
+  int base=int(src.size())-m.count;
+  if(base>0) return src[base-1].faceUp ? -1 : 3;  // turns a card over
+  return g.piles[m.to].cards.empty() ? -1 : 3;   // clears the column
+}
+
+bool bestMove(const Game& g,int drawCount,Move& m){
+  MoveList moves;
+  generateMoves(g,drawCount,moves);
+  int best=-1;
+  for(const Move& cand:moves){
+    int r=rankMove(g,cand);
+    if(r>best){ best=r; m=cand; }
+  }
+  return best>=0;
+}
+
+namespace {
+const char* const POLICY_NAMES[]={"random","greedy","solver"};
+
+// splitmix64, seeded per game so runs are reproducible on any thread
+struct BotRng {
+  uint64_t state;
+  uint64_t next(){
+    uint64_t z=(state+=0x9E3779B97F4A7C15ull);
+    z=(z^(z>>30))*0xBF58476D1CE4E5B9ull;
+    z=(z^(z>>27))*0x94D049BB133111EBull;
+    return z^(z>>31);
+  }
+};
+} // namespace
+
+const char* policyName(BotPolicy p){ return POLICY_NAMES[int(p)]; }
+
+bool parsePolicy(const char* name,BotPolicy& out){
+  for(int i=0;i<3;++i)
+    if(std::strcmp(name,POLICY_NAMES[i])==0){ out=BotPolicy(i); return true; }
+  return false;
+}
+
+Bot::Bot(BotPolicy policy,int drawCount,int maxMoves,SolverLimits limits)
+  :mPolicy(policy),mDrawCount(drawCount),mMaxMoves(maxMoves),mLimits(limits){
+  if(policy==BotPolicy::Solver) mSolver.reset(new Solver());
+}
+
+GameOutcome Bot::play(uint64_t seed,std::vector<Move>* line){
+  Game g;
+  g.initializeDeck(seed);
+  g.setupPiles();
+  GameOutcome out;
+  if(line) line->clear();
+  out.won=(mPolicy==BotPolicy::Solver) ? playSolved(g,line) : playMoves(g,seed,line);
+  out.moves=g.moveCount;
+  return out;
+}
+
+bool Bot::playMoves(Game& g,uint64_t seed,std::vector<Move>* line){
+  BotRng rng{seed};
+  MoveList moves;
+  StallDetector stall;
+  for(int played=0;played<mMaxMoves;++played){
+    Move m{};
+    if(mPolicy==BotPolicy::Greedy){
+      if(!bestMove(g,mDrawCount,m)) break;
+    } else {
+      generateMoves(g,mDrawCount,moves);
+      if(moves.empty()) break;
+      m=moves[int(rng.next()%uint64_t(moves.size()))];
+    }
+    g.applyMove(m);
+    if(line) line->push_back(m);
+    if(isSolved(g)) return true;
+    // greedy play is deterministic, so one repeated pass means it will
+    // repeat forever; random play may still find a way out unless the
+    // game is dead
+    stall.onMove(g,mDrawCount,m);
+    if(mPolicy==BotPolicy::Greedy ? stall.cycling() : stall.dead()) break;
+  }
+  return false;
+}
+
+bool Bot::playSolved(Game& g,std::vector<Move>* line){
+  SolveResult r=mSolver->solve(g,mDrawCount,mLimits);
+  if(r.status!=SolveStatus::Solved) return false;
+  for(Move m:r.moves) g.applyMove(m);
+  if(line) *line=r.moves;
+  return true;
+}
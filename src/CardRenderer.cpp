@@ -2,27 +2,30 @@
 #include "../include/CardRenderer.h"
 #include "../include/Constants.h"
 #include "../include/Utility.h"
-#include <SDL2/SDL_image.h>
+#include "../include/Profiler.h"
 #include <iostream>
 
-CardRenderer::CardRenderer(SDL_Renderer* R,TTF_Font* F)
- : mRenderer(R),mFont(F)
+CardRenderer::CardRenderer(SDL_Renderer* R,TTF_Font* F,SDL_Texture* const tex[TEXTURE_COUNT])
+ : mRenderer(R),mFont(F),mText(R,F)
 {
-  mSpadeTexture    = IMG_LoadTexture(R,SPADE_IMG);
-  mHeartTexture    = IMG_LoadTexture(R,HEART_IMG);
-  mDiamondTexture  = IMG_LoadTexture(R,DIAMOND_IMG);
-  mClubTexture     = IMG_LoadTexture(R,CLUB_IMG);
-  mCardBackTexture = IMG_LoadTexture(R,CARDBACK_IMG);
-  mJackTexture     = IMG_LoadTexture(R,JACK_IMG);
-  mQueenTexture    = IMG_LoadTexture(R,QUEEN_IMG);
-  mKingTexture     = IMG_LoadTexture(R,KING_IMG);
-  if(!mSpadeTexture||!mHeartTexture||!mDiamondTexture||!mClubTexture)
-    std::cerr<<"Suit texture error: "<<IMG_GetError()<<"\n";
-  if(!mCardBackTexture)
-    std::cerr<<"Cardback texture error: "<<IMG_GetError()<<"\n";
+  adoptTextures(tex);
+  rebuildAtlas();
 }
 
-CardRenderer::~CardRenderer(){
+CardRenderer::~CardRenderer(){ destroyTextures(); }
+
+void CardRenderer::adoptTextures(SDL_Texture* const tex[TEXTURE_COUNT]){
+  mSpadeTexture    = tex[TEX_SPADE];
+  mHeartTexture    = tex[TEX_HEART];
+  mDiamondTexture  = tex[TEX_DIAMOND];
+  mClubTexture     = tex[TEX_CLUB];
+  mCardBackTexture = tex[TEX_CARDBACK];
+  mJackTexture     = tex[TEX_JACK];
+  mQueenTexture    = tex[TEX_QUEEN];
+  mKingTexture     = tex[TEX_KING];
+}
+
+void CardRenderer::destroyTextures(){
   SDL_DestroyTexture(mSpadeTexture);
   SDL_DestroyTexture(mHeartTexture);
   SDL_DestroyTexture(mDiamondTexture);
@@ -31,6 +34,64 @@ CardRenderer::~CardRenderer(){
   SDL_DestroyTexture(mJackTexture);
   SDL_DestroyTexture(mQueenTexture);
   SDL_DestroyTexture(mKingTexture);
+  if(mAtlas) SDL_DestroyTexture(mAtlas);
+  mAtlas=nullptr;
+}
+
+void CardRenderer::replaceTextures(SDL_Texture* const tex[TEXTURE_COUNT]){
+  destroyTextures();
+  adoptTextures(tex);
+  rebuildAtlas();
+}
+
+void CardRenderer::rebuildAtlas(){
+  if(!SDL_RenderTargetSupported(mRenderer)) return;
+  if(!mAtlas){
+    mAtlas=SDL_CreateTexture(mRenderer,SDL_PIXELFORMAT_RGBA8888,SDL_TEXTUREACCESS_TARGET,
+                             13*CARD_WIDTH,5*CARD_HEIGHT);
+    if(!mAtlas){ std::cerr<<"Card atlas error: "<<SDL_GetError()<<"\n"; return; }
+  }
+  PROFILE_SCOPE("CardRenderer::rebuildAtlas");
+  PROFILE_COUNT(PROFILE_TEXTURE_UPLOADS,1);
+  SDL_Texture* previous=SDL_GetRenderTarget(mRenderer);
+  SDL_SetRenderTarget(mRenderer,mAtlas);
+  SDL_SetRenderDrawColor(mRenderer,0,0,0,0);
+  SDL_RenderClear(mRenderer);
+  for(int s=0;s<4;++s)
+    for(int v=1;v<=13;++v){
+      Card c=makeCard(v,s,true);
+      SDL_Rect r=atlasRect(c);
+      rasterizeCard(r.x,r.y,c);
+    }
+  Card back=makeCard(1,0,false);
+  SDL_Rect r=atlasRect(back);
+  rasterizeCard(r.x,r.y,back);
+  SDL_SetRenderTarget(mRenderer,previous);
+}
+
+SDL_Rect CardRenderer::atlasRect(const Card& c) const {
+  if(!c.faceUp) return {0,4*CARD_HEIGHT,CARD_WIDTH,CARD_HEIGHT};
+  return {(c.value-1)*CARD_WIDTH,c.suit*CARD_HEIGHT,CARD_WIDTH,CARD_HEIGHT};
+}
+
+void CardRenderer::drawCard(int x,int y,const Card& card){
+  PROFILE_SCOPE("CardRenderer::drawCard");
+  if(!mAtlas){ rasterizeCard(x,y,card); return; }
+  SDL_Rect src=atlasRect(card), dst{x,y,CARD_WIDTH,CARD_HEIGHT};
+  if(mBatching) mBatch.add(src,dst);
+  else { SDL_RenderCopy(mRenderer,mAtlas,&src,&dst); PROFILE_COUNT(PROFILE_DRAW_CALLS,1); }
+}
+
+void CardRenderer::beginBatch(){
+  mBatching=true;
+  mBatch.begin(mAtlas,13*CARD_WIDTH,5*CARD_HEIGHT);
+}
+
+int CardRenderer::flushBatch(){
+  mBatching=false;
+  int calls=mBatch.flush(mRenderer);
+  PROFILE_COUNT(PROFILE_DRAW_CALLS,calls);
+  return calls;
 }
 
 void CardRenderer::drawPipTexture(SDL_Texture* tex,int cx,int cy,int scale){
@@ -133,7 +194,7 @@ switch (val)
         }
 }
 
-void CardRenderer::drawCard(int x,int y,const Card& card)    {
+void CardRenderer::rasterizeCard(int x,int y,const Card& card)    {
         SDL_Rect cardRect{x, y, CARD_WIDTH, CARD_HEIGHT};
         if (card.faceUp)
         {
@@ -254,12 +315,5 @@ void CardRenderer::drawCard(int x,int y,const Card& card)    {
     }
 
 void CardRenderer::renderText(const std::string& txt,int x,int y){
-  SDL_Surface* s=TTF_RenderText_Blended(mFont,txt.c_str(),{255,255,255,255});
-  if(s){
-    SDL_Texture* t=SDL_CreateTextureFromSurface(mRenderer,s);
-    SDL_Rect d{x,y,s->w,s->h};
-    SDL_RenderCopy(mRenderer,t,nullptr,&d);
-    SDL_DestroyTexture(t);
-    SDL_FreeSurface(s);
-  }
+  mText.draw(txt,x,y);
 }
@@ -0,0 +1,75 @@
+// src/DealGenerator.cpp
+#include "../include/DealGenerator.h"
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+static constexpr uint64_t EASY_NODES   = 2000;
+static constexpr uint64_t MEDIUM_NODES = 50000;
+
+const char* difficultyName(Difficulty d){
+  switch(d){
+    case Difficulty::Easy:   return "Easy";
+    case Difficulty::Medium: return "Medium";
+    case Difficulty::Hard:   return "Hard";
+  }
+  return "";
+}
+
+SolverLimits gradingLimits(const std::atomic<bool>* stop){
+  SolverLimits l;
+  l.maxNodes=1000000;
+  l.maxMillis=60000;
+  l.stop=stop;
+  return l;
+}
+
+Difficulty classifyDifficulty(const SolveResult& r){
+  if(r.nodes<=EASY_NODES)   return Difficulty::Easy;
+  if(r.nodes<=MEDIUM_NODES) return Difficulty::Medium;
+  return Difficulty::Hard;
+}
+
+SolveResult solveDeal(Solver& solver,uint64_t seed,int drawCount,const std::atomic<bool>* stop){
+  Game g;
+  g.initializeDeck(seed);
+  g.setupPiles();
+  return solver.solve(g,drawCount,gradingLimits(stop));
+}
+
+bool gradeDeal(Solver& solver,uint64_t seed,int drawCount,Difficulty& out,
+               const std::atomic<bool>* stop){
+  SolveResult r=solveDeal(solver,seed,drawCount,stop);
+  if(r.status!=SolveStatus::Solved) return false;
+  out=classifyDifficulty(r);
+  return true;
+}
+
+std::vector<uint64_t> findWinnableDeals(int count,Difficulty difficulty,int drawCount,
+                                        uint64_t firstSeed,int threads){
+  if(threads<=0) threads=int(std::max(1u,std::thread::hardware_concurrency()));
+  std::atomic<uint64_t> nextSeed{firstSeed};
+  std::atomic<int> found{0};
+  std::mutex lock;
+  std::vector<uint64_t> hits;
+
+  auto work=[&]{
+    Solver solver;
+    while(found.load()<count){
+      uint64_t seed=nextSeed.fetch_add(1);
+      Difficulty d;
+      if(!gradeDeal(solver,seed,drawCount,d) || d!=difficulty) continue;
+      std::lock_guard<std::mutex> lk(lock);
+      hits.push_back(seed);
+      found.fetch_add(1);
+    }
+  };
+  std::vector<std::thread> pool;
+  for(int i=0;i<threads;++i) pool.emplace_back(work);
+  for(auto& t:pool) t.join();
+
+  // threads overshoot a little; keep the lowest seeds so results are stable
+  std::sort(hits.begin(),hits.end());
+  if((int)hits.size()>count) hits.resize(count);
+  return hits;
+}
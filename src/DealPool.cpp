@@ -0,0 +1,59 @@
+// src/DealPool.cpp
+#include "../include/DealPool.h"
+#include <random>
+
+static constexpr size_t FRESH_TARGET = 4;
+
+DealPool::DealPool(int drawCount)
+ : mDrawCount(drawCount),mNextBuiltin{}{
+  std::mt19937 g(std::random_device{}());
+  for(auto& n:mNextBuiltin) n=g()%BUILTIN_WINNABLE_COUNT;
+  mWorker=std::thread([this]{ refill(); });
+}
+
+DealPool::~DealPool(){
+  // mStop also stops a solve that is only just starting, which cancel()
+  // would miss: solve() clears its cancel flag on entry
+  {
+    std::lock_guard<std::mutex> lk(mLock);
+    mStop=true;
+  }
+  mWake.notify_all();
+  mWorker.join();
+}
+
+uint64_t DealPool::take(Difficulty d){
+  int i=int(d);
+  std::lock_guard<std::mutex> lk(mLock);
+  uint64_t seed;
+  if(!mFresh[i].empty()){
+    seed=mFresh[i].front();
+    mFresh[i].pop_front();
+  } else {
+    seed=BUILTIN_WINNABLE_DEALS[mDrawCount==3][i][mNextBuiltin[i]];
+    mNextBuiltin[i]=(mNextBuiltin[i]+1)%BUILTIN_WINNABLE_COUNT;
+  }
+  mWake.notify_all();
+  return seed;
+}
+
+// Grade random seeds in the background until every difficulty has a few
+// fresh deals queued, then sleep until take() uses one up.
+void DealPool::refill(){
+  while(!mStop){
+    {
+      std::unique_lock<std::mutex> lk(mLock);
+      mWake.wait(lk,[&]{
+        if(mStop) return true;
+        for(auto& q:mFresh) if(q.size()<FRESH_TARGET) return true;
+        return false;
+      });
+      if(mStop) return;
+    }
+    uint64_t seed=randomDealSeed();
+    Difficulty d;
+    if(!gradeDeal(mSolver,seed,mDrawCount,d,&mStop)) continue;
+    std::lock_guard<std::mutex> lk(mLock);
+    if(mFresh[int(d)].size()<FRESH_TARGET) mFresh[int(d)].push_back(seed);
+  }
+}
@@ -0,0 +1,22 @@
+// src/FrameScheduler.cpp
+#include "../include/FrameScheduler.h"
+
+FrameScheduler::FrameScheduler(SDL_Renderer* R,int hz)
+ : mRenderer(R),mPeriodMs(Uint32(1000/hz)){}
+
+int FrameScheduler::waitTimeout(bool animating,int nextUpdateMs){
+  // vsync only while something moves; an idle present should not block
+  if(animating!=mVSync && mVSyncWorks){
+    if(SDL_RenderSetVSync(mRenderer,animating?1:0)==0) mVSync=animating;
+    else mVSyncWorks=false;
+  }
+  if(animating){
+    if(mVSync) return 0; // SDL_RenderPresent waits for the display
+    Uint32 spent=SDL_GetTicks()-mLastPresent;
+    return spent>=mPeriodMs ? 0 : int(mPeriodMs-spent);
+  }
+  if(nextUpdateMs<0 || nextUpdateMs>MAX_IDLE_WAIT_MS) return MAX_IDLE_WAIT_MS;
+  return nextUpdateMs;
+}
+
+void FrameScheduler::framePresented(){ mLastPresent=SDL_GetTicks(); }
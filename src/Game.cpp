@@ -1,80 +1,193 @@
 // src/Game.cpp
 #include "../include/Game.h"
-#include "../include/Utility.h"
+#include "../include/MoveGen.h"
+#include "../include/Zobrist.h"
 #include <algorithm>
 #include <random>
 
-Game::Game():mode(RANDOM),score(0),moveCount(0){}
+Game::Game():mode(RANDOM),score(0),moveCount(0),seed(0),hash(0),deck{},piles{}{}
 
-void Game::initializeDeck(){
-  deck.clear();
+namespace {
+// splitmix64: tiny, fast and fully specified, unlike std::mt19937 +
+// std::shuffle whose output differs between standard libraries
+struct DealRng {
+  uint64_t state;
+  uint64_t next(){
+    uint64_t z=(state+=0x9E3779B97F4A7C15ull);
+    z=(z^(z>>30))*0xBF58476D1CE4E5B9ull;
+    z=(z^(z>>27))*0x94D049BB133111EBull;
+    return z^(z>>31);
+  }
+  // Unbiased value in [0,n)
+  uint32_t below(uint32_t n){
+    uint64_t limit=UINT64_MAX-UINT64_MAX%n;
+    uint64_t r;
+    do r=next(); while(r>=limit);
+    return uint32_t(r%n);
+  }
+};
+} // namespace
+
+void Game::initializeDeck(uint64_t dealSeed){
+  seed=dealSeed;
+  int n=0;
   for(int s=0;s<4;++s)
     for(int v=1;v<=13;++v)
-      deck.push_back({v,s,false});
-  if(mode==RANDOM){
-    std::mt19937 g(std::random_device{}());
-    std::shuffle(deck.begin(),deck.end(),g);
-  } else {
-    std::sort(deck.begin(),deck.end(),[](auto&a,auto&b){
-      return (a.suit==b.suit)?(a.value<b.value):(a.suit<b.suit);
-    });
-  }
+      deck[n++]=makeCard(v,s,false);
+  DealRng rng{dealSeed};
+  for(int i=n-1;i>0;--i)
+    std::swap(deck[i],deck[rng.below(uint32_t(i+1))]);
+}
+
+uint64_t randomDealSeed(){
+  thread_local std::mt19937_64 g(std::random_device{}());
+  // keep deal numbers short enough to read out and type back in
+  return std::uniform_int_distribution<uint64_t>(1,UINT32_MAX)(g);
 }
 
 void Game::setupPiles(){
-  piles.clear();
-  piles.push_back({STOCK,50,50,{}});
-  piles.push_back({WASTE,130,50,{}});
-  for(int i=0;i<4;++i)
-    piles.push_back({FOUNDATION,400+i*(CARD_WIDTH+20),50,{}});
-  for(int i=0;i<7;++i)
-    piles.push_back({TABLEAU,50+i*(CARD_WIDTH+20),200,{}});
+  piles[STOCK_PILE].type=STOCK;
+  piles[WASTE_PILE].type=WASTE;
+  for(int i=FIRST_FOUNDATION;i<FIRST_TABLEAU;++i) piles[i].type=FOUNDATION;
+  for(int i=FIRST_TABLEAU;i<PILE_COUNT;++i) piles[i].type=TABLEAU;
+  for(auto& p:piles) p.cards.clear();
+  hash=0;
   int idx=0;
   for(int i=0;i<7;++i){
     for(int j=0;j<=i;++j){
       Card c=deck[idx++]; c.faceUp=(j==i);
-      piles[6+i].cards.push_back(c);
+      pushCard(FIRST_TABLEAU+i,c);
     }
   }
   while(idx<(int)deck.size()){
     Card c=deck[idx++]; c.faceUp=false;
-    piles[0].cards.push_back(c);
+    pushCard(STOCK_PILE,c);
   }
   moveCount=0;
 }
 
 bool Game::canPlaceOnFoundation(const Card& c,const Pile& f) const {
-  if(f.cards.empty()) return c.value==1;
-  auto& top=f.cards.back();
-  return c.suit==top.suit && c.value==top.value+1;
+  return ::canPlaceOnFoundation(c,f);
 }
 
 bool Game::moveCardToFoundation(int sp,int ci){
   Card c=piles[sp].cards[ci];
-  for(int i=2;i<6;++i){
-    if(canPlaceOnFoundation(c,piles[i])){
-      piles[i].cards.push_back(c);
-      piles[sp].cards.erase(piles[sp].cards.begin()+ci);
-      score+=10; moveCount++;
-      return true;
-    }
-  }
-  return false;
+  int f=foundationFor(*this,c);
+  if(f<0) return false;
+  removeCard(sp,ci);
+  pushCard(f,c);
+  score+=10; moveCount++;
+  return true;
 }
 
 void Game::handleStockClick(int drawCount){
-  auto& stock=piles[0];
-  auto& waste=piles[1];
-  if(!stock.cards.empty()){
-    for(int i=0;i<drawCount&& !stock.cards.empty();++i){
-      Card c=stock.cards.back(); stock.cards.pop_back();
-      c.faceUp=true; waste.cards.push_back(c);
+  Move m{};
+  if(stockMove(drawCount,m)) applyMove(m);
+}
+
+bool Game::stockMove(int drawCount,Move& m) const {
+  int stock=int(piles[STOCK_PILE].cards.size());
+  int waste=int(piles[WASTE_PILE].cards.size());
+  if(stock>0) m=makeMove(MOVE_DRAW,STOCK_PILE,WASTE_PILE,std::min(drawCount,stock));
+  else if(waste>0) m=makeMove(MOVE_RECYCLE,WASTE_PILE,STOCK_PILE,waste);
+  else return false;
+  return true;
+}
+
+void Game::applyMove(Move& m){
+  switch(m.kind){
+  case MOVE_DRAW:
+    for(int i=0;i<m.count;++i){
+      Card c=popCard(STOCK_PILE); c.faceUp=true; pushCard(WASTE_PILE,c);
     }
     moveCount++;
-  } else if(!waste.cards.empty()){
-    while(!waste.cards.empty()){
-      Card c=waste.cards.back(); waste.cards.pop_back();
-      c.faceUp=false; stock.cards.push_back(c);
+    break;
+  case MOVE_RECYCLE:
+    for(int i=0;i<m.count;++i){
+      Card c=popCard(WASTE_PILE); c.faceUp=false; pushCard(STOCK_PILE,c);
     }
+    break;
+  case MOVE_CARDS: {
+    auto& src=piles[m.from].cards;
+    int base=int(src.size())-m.count;
+    for(int i=0;i<m.count;++i) pushCard(m.to,src[base+i]);
+    for(int i=0;i<m.count;++i) popCard(m.from);
+    if(piles[m.to].type==FOUNDATION) score+=10;
+    if(piles[m.from].type==FOUNDATION) score-=10;
+    moveCount++;
+    m.flipped=!src.empty()&&!src.back().faceUp;
+    if(m.flipped) setFaceUp(m.from,int(src.size())-1,true);
+    break;
+  }
   }
 }
+
+void Game::undoMove(const Move& m){
+  switch(m.kind){
+  case MOVE_DRAW:
+    for(int i=0;i<m.count;++i){
+      Card c=popCard(WASTE_PILE); c.faceUp=false; pushCard(STOCK_PILE,c);
+    }
+    moveCount--;
+    break;
+  case MOVE_RECYCLE:
+    for(int i=0;i<m.count;++i){
+      Card c=popCard(STOCK_PILE); c.faceUp=true; pushCard(WASTE_PILE,c);
+    }
+    break;
+  case MOVE_CARDS: {
+    auto& src=piles[m.from].cards;
+    auto& dst=piles[m.to].cards;
+    if(m.flipped) setFaceUp(m.from,int(src.size())-1,false);
+    int base=int(dst.size())-m.count;
+    for(int i=0;i<m.count;++i) pushCard(m.from,dst[base+i]);
+    for(int i=0;i<m.count;++i) popCard(m.to);
+    if(piles[m.to].type==FOUNDATION) score-=10;
+    if(piles[m.from].type==FOUNDATION) score+=10;
+    moveCount--;
+    break;
+  }
+  }
+}
+
+void Game::pushCard(int p,Card c){
+  auto& cs=piles[p].cards;
+  hash^=zobristKey(c,p,int(cs.size()));
+  cs.push_back(c);
+}
+
+Card Game::popCard(int p){
+  auto& cs=piles[p].cards;
+  Card c=cs.back(); cs.pop_back();
+  hash^=zobristKey(c,p,int(cs.size()));
+  return c;
+}
+
+Card Game::removeCard(int p,int ci){
+  auto& cs=piles[p].cards;
+  int n=int(cs.size());
+  for(int i=ci;i<n;++i) hash^=zobristKey(cs[i],p,i);
+  Card c=cs[ci];
+  for(int i=ci+1;i<n;++i){
+    cs[i-1]=cs[i];
+    hash^=zobristKey(cs[i-1],p,i-1);
+  }
+  cs.pop_back();
+  return c;
+}
+
+void Game::setFaceUp(int p,int ci,bool up){
+  Card& c=piles[p].cards[ci];
+  if(c.faceUp==up) return;
+  hash^=zobristKey(c,p,ci);
+  c.faceUp=up;
+  hash^=zobristKey(c,p,ci);
+}
+
+uint64_t Game::computeHash() const {
+  uint64_t h=0;
+  for(int p=0;p<PILE_COUNT;++p)
+    for(int i=0;i<(int)piles[p].cards.size();++i)
+      h^=zobristKey(piles[p].cards[i],p,i);
+  return h;
+}
@@ -1,14 +1,33 @@
 // src/GameEngine.cpp
 #include "../include/GameEngine.h"
 #include "../include/Utility.h"
+#include "../include/Layout.h"
+#include "../include/Bot.h"
+#include "../include/Profiler.h"
 #include <SDL2/SDL.h>
+#include <cstdio>
+#include <iostream>
     DragState dragState;
 
-GameEngine::GameEngine(SDL_Renderer *R, TTF_Font *F)
-    : mRenderer(R), mFont(F),
-      mCardRenderer(R, F),
-      mSoundManager(),
-      mGame(),
+namespace {
+// Worker threads call this when they have something new to show
+void wakeEventLoop()
+{
+    SDL_Event e{};
+    e.type = SDL_USEREVENT;
+    SDL_PushEvent(&e);
+}
+} // namespace
+
+GameEngine::GameEngine(SDL_Renderer *R, const StartupAssets &assets)
+    : mRenderer(R), mFont(assets.font), mBundle(assets.bundle),
+      mCardRenderer(R, assets.font, assets.textures),
+      mBoardCache(R),
+      mCascade(R),
+      mSoundManager(assets.moveSound, assets.moveSoundSize),
+      mSim(wakeEventLoop),
+      mHints(HINT_BUDGET_MS, wakeEventLoop),
+      mWinnable(SolverLimits{2000000, WINNABLE_BUDGET_MS}, wakeEventLoop),
       menuText("Welcome to Solitaire"),
       mStartTime(SDL_GetTicks())
 {
@@ -16,21 +35,47 @@ GameEngine::GameEngine(SDL_Renderer *R, TTF_Font *F)
     setupSettingsButtons();
     setupStatisticsButtons();
     setupPlayingButtons();
+    setupReplayButtons();
+    mSolvabilityDB.open(SOLVABILITY_DB_FILE);
+}
+
+GameEngine::~GameEngine()
+{
+    // saves the game in progress
+    mSim.stop();
 }
 
 void GameEngine::startNewGame()
 {
-    mGame.score = 0;
-    mGame.initializeDeck();
-    mGame.setupPiles();
-    while (!undoStack.empty())
-        undoStack.pop();
-    undoStack.push(mGame);
-    mStartTime = SDL_GetTicks();
     mDrawCount = 1;
+    // WINNING mode deals only seeds the solver has proven winnable
+    uint64_t seed;
+    if (mMode != WINNING)
+        seed = randomDealSeed();
+    else if (!pickWinnableSeed(seed))
+        seed = mDealPool.take(mDifficulty);
+    // the rules thread saves the old game's replay before dealing
+    SimCommand deal;
+    deal.kind = SimCommandKind::NewGame;
+    deal.seed = seed;
+    deal.mode = mMode;
+    mNewGameSeq = mSim.post(deal);
+    mDealRecord = DealRecord();
+    if (mSolvabilityDB.drawCount() == mDrawCount)
+        mSolvabilityDB.lookup(seed, mDealRecord);
+    mPredictedCount = 0;
+    mInFlight.fill(0);
+    dragState.dragging = false;
+    mAnimations.clear();
+    mCascade.stop();
+    mStartTime = SDL_GetTicks();
     paused = false;
     win = false;
     hintActive = false;
+    hintMessage.clear();
+    mHintWanted = false;
+    mWinnability = Winnability::Analyzing;
+    refreshView();
 }
 
 void GameEngine::setupMenuButtons()
@@ -45,6 +90,8 @@ void GameEngine::setupMenuButtons()
                               { state = STATISTICS; });
     mMenuButtons.emplace_back(410, 610, 200, 50, "Quit", [&]()
                               { mQuit = true; });
+    mMenuButtons.emplace_back(410, 680, 200, 50, "Watch Replay", [&]()
+                              { openLastReplay(); });
 }
 
 void GameEngine::setupSettingsButtons()
@@ -52,7 +99,9 @@ void GameEngine::setupSettingsButtons()
     mSettingsButtons.clear();
     mSettingsButtons.push_back(Button(400, 400, 200, 50, "Toggle Sound", [this]()
                                       { mSoundManager.toggleSound(); }));
-    mSettingsButtons.push_back(Button(400, 470, 200, 50, "Back", [this]()
+    mSettingsButtons.push_back(Button(400, 470, 200, 50, "Difficulty", [this]()
+                                      { mDifficulty = Difficulty((int(mDifficulty) + 1) % DIFFICULTY_COUNT); }));
+    mSettingsButtons.push_back(Button(400, 540, 200, 50, "Back", [this]()
                                       { state = MENU; }));
 }
 
@@ -74,115 +123,388 @@ void GameEngine::setupPlayingButtons()
     mPlayingButtons.push_back(Button(800, 150, 150, 40, "Restart", [this]()
                                      { startNewGame(); }));
     mPlayingButtons.push_back(Button(800, 200, 150, 40, "Undo", [this]()
-                                     {
-            if (undoStack.size() > 1) {
-                undoStack.pop();
-                mGame = undoStack.top();
-            } }));
+                                     { undoMove(); }));
     mPlayingButtons.push_back(Button(800, 250, 150, 40, "Toggle Draw", [this]()
                                      { mDrawCount = (mDrawCount == 1) ? 3 : 1; }));
     mPlayingButtons.push_back(Button(800, 300, 150, 40, "Pause/Resume", [this]()
                                      { paused = !paused; }));
     mPlayingButtons.push_back(Button(800, 350, 150, 40, "Hint", [this]()
-                                     {
-            int hp, hc, dest;
-            if (findHint(hp, hc, dest)) {
-                hintPileIndex = hp;
-                hintCardIndex = hc;
-                hintStartTime = SDL_GetTicks();
-                hintActive = true;
-            } }));
+                                     { showHint(); }));
     mPlayingButtons.push_back(Button(800, 400, 150, 40, "Auto-Complete", [this]()
                                      { autoComplete(); }));
+    mPlayingButtons.push_back(Button(800, 450, 150, 40, "Redo", [this]()
+                                     { redoMove(); }));
 }
 
-void GameEngine::animateAutoMove(int sp, int ci, int dp, int sx, int sy, int dx, int dy)
+void GameEngine::setupReplayButtons()
 {
-    Card c = mGame.piles[sp].cards[ci];
-    mGame.piles[sp].cards.erase(mGame.piles[sp].cards.begin() + ci);
-    animateCardMove(c, sx, sy, dx, dy, 500, [&, c, sp, dp]()
-                    {
-    mGame.piles[dp].cards.push_back(c);
-    mGame.score+=10; mGame.moveCount++;
-    auto& o=mGame.piles[sp];
-    if(!o.cards.empty()&&!o.cards.back().faceUp) o.cards.back().faceUp=true;
-    mSoundManager.playMoveSound();
-    checkWin(); });
+    mReplayButtons.clear();
+    mReplayButtons.push_back(Button(800, 150, 150, 40, "Menu", [this]()
+                                    { state = MENU; }));
+    mReplayButtons.push_back(Button(800, 200, 150, 40, "Start", [this]()
+                                    { mReplay.seek(0); }));
+    mReplayButtons.push_back(Button(800, 250, 150, 40, "Back 1", [this]()
+                                    { mReplay.step(-1); }));
+    mReplayButtons.push_back(Button(800, 300, 150, 40, "Forward 1", [this]()
+                                    { mReplay.step(1); }));
+    mReplayButtons.push_back(Button(800, 350, 150, 40, "End", [this]()
+                                    { mReplay.seek(mReplay.length()); }));
 }
 
+void GameEngine::postMove(Move m)
+{
+    SimCommand c;
+    c.kind = SimCommandKind::Move;
+    c.drawCount = uint8_t(mDrawCount);
+    c.move = m;
+    c.seq = mSim.post(c);
+    if (c.seq != 0 && mPredictedCount < (int)mPredicted.size())
+        mPredicted[mPredictedCount++] = c;
+    refreshView();
+}
+
+void GameEngine::refreshView()
+{
+    mSim.refresh();
+    const SimSnapshot &s = mSim.snapshot();
+    int kept = 0;
+    for (int i = 0; i < mPredictedCount; i++)
+        if (mPredicted[i].seq > s.ackSeq)
+            mPredicted[kept++] = mPredicted[i];
+    mPredictedCount = kept;
+
+    mView = s.game;
+    // the rules thread checks these again; one it rejects just disappears
+    for (int i = 0; i < mPredictedCount; i++)
+    {
+        Move m = mPredicted[i].move;
+        if (isLegalMove(mView, mPredicted[i].drawCount, m))
+            mView.applyMove(m);
+    }
+    for (int p = 0; p < PILE_COUNT; p++)
+        for (int k = 0; k < mInFlight[p] && !mView.piles[p].cards.empty(); k++)
+            mView.popCard(p);
+    if (dragState.dragging)
+        while ((int)mView.piles[dragState.originPileIndex].cards.size() > dragState.originCardIndex)
+            mView.popCard(dragState.originPileIndex);
+}
+
+bool GameEngine::boardSynced() const
+{
+    return mSim.snapshot().ackSeq >= mNewGameSeq;
+}
+
+void GameEngine::undoMove()
+{
+    // Cards in flight or in hand are not on any pile yet; let them land first
+    if (!mAnimations.empty() || dragState.dragging)
+        return;
+    SimCommand c;
+    c.kind = SimCommandKind::Undo;
+    mSim.post(c);
+    hintActive = false;
+}
+
+void GameEngine::redoMove()
+{
+    if (!mAnimations.empty() || dragState.dragging)
+        return;
+    SimCommand c;
+    c.kind = SimCommandKind::Redo;
+    mSim.post(c);
+    hintActive = false;
+}
+
+const BoardLayout &GameEngine::layout()
+{
+    mLayout.update(mView);
+    return mLayout;
+}
+
+void GameEngine::animateAutoMove(int sp, int ci, int dp)
+{
+    PileOrigin from = layout().cardPos(sp, ci);
+    PileOrigin to = mLayout.cardPos(dp, mLayout.pileSize(dp));
+    int sx = from.x, sy = from.y, dx = to.x, dy = to.y;
+    Card c = mView.piles[sp].cards[ci];
+    Move m = makeMove(MOVE_CARDS, sp, dp, 1);
+    mInFlight[sp]++;
+    refreshView();
+    // with the pool full the card lands at once
+    if (!mAnimations.moveCard(c, sx, sy, dx, dy, 500, AnimDone::CommitMove, m))
+        onAnimationDone(AnimEvent{AnimDone::CommitMove, c, m});
+}
+
+void GameEngine::onAnimationDone(const AnimEvent &ev)
+{
+    if (ev.done == AnimDone::CommitMove)
+    {
+        mInFlight[ev.move.from]--;
+        postMove(ev.move);
+        mSoundManager.playMoveSound();
+    }
+}
+
+// Follows the rules thread's verdict; the winning replay is saved there
 void GameEngine::checkWin()
 {
-    if (!mGame.piles[0].cards.empty() || !mGame.piles[1].cards.empty())
+    const SimSnapshot &s = mSim.snapshot();
+    if (!boardSynced() || s.won == win)
+        return;
+    win = s.won;
+    if (!win)
+    {
+        mCascade.stop();
         return;
-    for (size_t i = 6; i < mGame.piles.size(); ++i)
-        if (!mGame.piles[i].cards.empty())
-            return;
-    win = true;
+    }
+    if (!mCascade.visible())
+        mCascade.start(s.game, s.game.seed, SDL_GetTicks());
     Uint32 t = (SDL_GetTicks() - mStartTime) / 1000;
     if (t < bestTime)
         bestTime = t;
-    if (mGame.moveCount < bestMoves)
-        bestMoves = mGame.moveCount;
+    if (s.game.moveCount < bestMoves)
+        bestMoves = s.game.moveCount;
 }
 
-bool GameEngine::findHint(int &hp, int &hc, int &dest)
+bool GameEngine::gameDead() const
 {
-    auto &w = mGame.piles[1];
-    if (!w.cards.empty() && w.cards.back().faceUp)
+    return boardSynced() && mSim.snapshot().dead && !win;
+}
+
+void GameEngine::endGame()
+{
+    saveCurrentReplay();
+    state = MENU;
+    menuText = "Game over: the game looked stuck";
+}
+
+// The search runs on the hint thread; usually the position was searched
+// while the player was thinking and the answer is already there
+void GameEngine::showHint()
+{
+    hintActive = false;
+    hintMessage.clear();
+    mHintWanted = true;
+    mHints.request(mView, mDrawCount);
+    pollHint();
+}
+
+void GameEngine::pollHint()
+{
+    bool found = false;
+    HintResult r;
+    if (!mHints.lookup(mView, mDrawCount, found, r))
     {
-        for (int f = 2; f < 6; ++f)
-        {
-            if (mGame.canPlaceOnFoundation(w.cards.back(), mGame.piles[f]))
-            {
-                hp = 1;
-                hc = w.cards.size() - 1;
-                dest = f;
-                return true;
-            }
-        }
+        // the board may have moved on since it was asked for
+        mHints.request(mView, mDrawCount);
+        return;
     }
-    for (int i = 6; i < (int)mGame.piles.size(); ++i)
+    mHintWanted = false;
+    mNeedsRender = true;
+    hintStartTime = SDL_GetTicks();
+    if (found)
+    {
+        hintPileIndex = r.move.from;
+        hintCardIndex = (int)mView.piles[r.move.from].cards.size() - r.move.count;
+        hintActive = true;
+    }
+    if (dealRecord().status == DealStatus::Unwinnable)
+        hintMessage = "This deal cannot be won";
+    else
+        hintMessage = found ? "" : "No hint";
+}
+
+// The database entry for this deal; it says nothing once Toggle Draw has
+// switched to a draw setting the database was not solved for
+DealRecord GameEngine::dealRecord() const
+{
+    if (mSolvabilityDB.drawCount() != mDrawCount)
+        return DealRecord();
+    return mDealRecord;
+}
+
+// Pick a winnable deal at the chosen difficulty from the database by
+// probing random entries; each probe is a single array read.
+bool GameEngine::pickWinnableSeed(uint64_t &seed)
+{
+    if (!mSolvabilityDB.isOpen() || mSolvabilityDB.count() == 0 ||
+        mSolvabilityDB.drawCount() != mDrawCount)
+        return false;
+    uint64_t first = mSolvabilityDB.firstSeed(), n = mSolvabilityDB.count();
+    for (int tries = 0; tries < 64; ++tries)
     {
-        auto &p = mGame.piles[i];
-        if (!p.cards.empty() && p.cards.back().faceUp)
+        uint64_t candidate = first + randomDealSeed() % n;
+        DealRecord r;
+        if (mSolvabilityDB.lookup(candidate, r) && r.status == DealStatus::Winnable &&
+            r.difficulty == mDifficulty)
         {
-            for (int f = 2; f < 6; ++f)
-            {
-                if (mGame.canPlaceOnFoundation(p.cards.back(), mGame.piles[f]))
-                {
-                    hp = i;
-                    hc = p.cards.size() - 1;
-                    dest = f;
-                    return true;
-                }
-            }
+            seed = candidate;
+            return true;
         }
     }
     return false;
 }
 
+// Has the rules thread write the game so far to disk; returns the command's
+// sequence number, done once the snapshot's ackSeq reaches it
+uint32_t GameEngine::saveCurrentReplay()
+{
+    SimCommand c;
+    c.kind = SimCommandKind::SaveReplay;
+    return mSim.post(c);
+}
+
+// The replay opens from update() once the game so far is on disk
+void GameEngine::openLastReplay()
+{
+    mReplaySaveSeq = saveCurrentReplay();
+    if (mReplaySaveSeq == 0)
+        loadLastReplay();
+}
+
+void GameEngine::loadLastReplay()
+{
+    if (mReplay.load(REPLAY_LAST_FILE))
+        state = REPLAY;
+    else
+        menuText = "No replay recorded yet";
+}
+
 void GameEngine::autoComplete()
 {
-    int hp, hc, d;
-    if (findHint(hp, hc, d))
+    // a pile with a card already in the air shows the wrong top card
+    if (dragState.dragging || !boardSynced())
+        return;
+    MoveList moves;
+    generateMoves(mView, mDrawCount, moves);
+    for (const Move &m : moves)
+    {
+        if (mView.piles[m.to].type != FOUNDATION || mInFlight[m.from] != 0)
+            continue;
+        animateAutoMove(m.from, (int)mView.piles[m.from].cards.size() - 1, m.to);
+        return;
+    }
+}
+
+bool GameEngine::isAnimating() const
+{
+    return !mAnimations.empty() || dragState.dragging || mCascade.running();
+}
+
+int GameEngine::msUntilUpdate() const
+{
+    Uint32 now = SDL_GetTicks();
+    int wait = -1;
+    if (hintActive || !hintMessage.empty())
+    {
+        Uint32 shown = now - hintStartTime;
+        wait = shown >= HINT_MS ? 0 : int(HINT_MS - shown);
+    }
+    if (state == PLAYING && !paused)
     {
-        int sx = (hp == 1 ? mGame.piles[1].x : mGame.piles[hp].x);
-        int sy = (hp == 1 ? mGame.piles[1].y : mGame.piles[hp].y + hc * CARD_SPACING_Y);
-        int dx = mGame.piles[d].x, dy = mGame.piles[d].y;
-        animateAutoMove(hp, hc, d, sx, sy, dx, dy);
+        int tick = 1000 - int((now - mStartTime) % 1000);
+        if (wait < 0 || tick < wait)
+            wait = tick;
     }
+    return wait;
 }
 
 void GameEngine::update()
 {
+    PROFILE_SCOPE("GameEngine::update");
+    refreshView();
+    checkWin();
+    if (mReplaySaveSeq != 0 && mSim.snapshot().ackSeq >= mReplaySaveSeq)
+    {
+        mReplaySaveSeq = 0;
+        loadLastReplay();
+        mNeedsRender = true;
+    }
+    // search the position while the player looks at it
+    if (mHintWanted)
+        pollHint();
+    else if (state == PLAYING && !paused && !isAnimating() && boardSynced())
+        mHints.request(mView, mDrawCount);
+    // a settled board only: mid-drag the view is missing cards
+    if (state == PLAYING && !isAnimating() && boardSynced())
+    {
+        mWinnable.request(mView, mDrawCount);
+        Winnability w = mWinnable.status(mView, mDrawCount);
+        if (w != mWinnability)
+        {
+            mWinnability = w;
+            mNeedsRender = true;
+        }
+    }
+    // landed cards take effect before the frame is drawn
+    int landed = mAnimations.advance(SDL_GetTicks());
+    for (int i = 0; i < landed; i++)
+        onAnimationDone(mAnimations.event(i));
+    // anything moving, or a hint timing out, needs the next frame
+    if (!mAnimations.empty() || landed > 0 || mCascade.running())
+        mNeedsRender = true;
+    if ((hintActive || !hintMessage.empty()) && SDL_GetTicks() - hintStartTime >= HINT_MS)
+    {
+        hintActive = false;
+        hintMessage.clear();
+        mNeedsRender = true;
+    }
+    // the board changed since it was last drawn
+    if (state == PLAYING && mView.hash != mDrawnHash)
+        mNeedsRender = true;
     if (state == PLAYING && !paused)
     {
-        // …
+        Uint32 second = (SDL_GetTicks() - mStartTime) / 1000;
+        if (second != mShownSecond)
+            mNeedsRender = true;
+    }
+}
+
+// The piles of `g` from the retained board texture, redrawing only piles
+// that changed; falls back to drawing every card when there is no cache
+void GameEngine::renderSettledBoard(const Game &g, BoardLayout &L)
+{
+    L.update(g);
+    if (mBoardCache.valid())
+    {
+        mBoardCache.update(g, L, mCardRenderer);
+        mBoardCache.draw();
+        mCardRenderer.beginBatch();
+    }
+    else
+    {
+        mCardRenderer.beginBatch();
+        renderBoard(g, L);
+    }
+}
+
+// Queues every card of `g` on the card batch; the caller flushes it
+void GameEngine::renderBoard(const Game &g, const BoardLayout &L)
+{
+    SDL_Rect outlines[PILE_COUNT];
+    for (int p = 0; p < PILE_COUNT; p++)
+    {
+        PileOrigin o = pileOrigin(p);
+        outlines[p] = SDL_Rect{o.x, o.y, CARD_WIDTH, CARD_HEIGHT};
+    }
+    SDL_SetRenderDrawColor(mRenderer, 50, 50, 50, 255);
+    SDL_RenderDrawRects(mRenderer, outlines, PILE_COUNT);
+    PROFILE_COUNT(PROFILE_DRAW_CALLS, 1);
+    for (int p = 0; p < PILE_COUNT; p++)
+    {
+        const Pile &pile = g.piles[p];
+        for (int i = 0; i < (int)pile.cards.size(); i++)
+        {
+            PileOrigin at = L.cardPos(p, i);
+            mCardRenderer.drawCard(at.x, at.y, pile.cards[i]);
+        }
     }
 }
 
 void GameEngine::render()
 {
+    PROFILE_SCOPE("GameEngine::render");
+    mNeedsRender = false;
 
     int mx, my;
     Uint32 mb = SDL_GetMouseState(&mx, &my);
@@ -195,6 +517,8 @@ void GameEngine::render()
         b.update(mx, my, down);
     for (auto &b : mPlayingButtons)
         b.update(mx, my, down);
+    for (auto &b : mReplayButtons)
+        b.update(mx, my, down);
 
     if (state == MENU)
     {
@@ -202,14 +526,15 @@ void GameEngine::render()
         TTF_SizeText(mFont, menuText.c_str(), &textWidth, nullptr);
         mCardRenderer.renderText(menuText, (WINDOW_WIDTH/2) - textWidth/2, 300);
         for (auto &b : mMenuButtons)
-            b.render(mRenderer, mFont);
+            b.render(mRenderer, mCardRenderer.textCache());
     }
     else if (state == SETTINGS)
     {
         mCardRenderer.renderText("Settings", 400, 200);
         mCardRenderer.renderText("Sound: " + std::string(mSoundManager.isSoundOn() ? "On" : "Off"), 400, 300);
+        mCardRenderer.renderText("Winnable deals: " + std::string(difficultyName(mDifficulty)), 400, 330);
         for (auto &b : mSettingsButtons)
-            b.render(mRenderer, mFont);
+            b.render(mRenderer, mCardRenderer.textCache());
     }
     else if (state == STATISTICS)
     {
@@ -217,58 +542,73 @@ void GameEngine::render()
         mCardRenderer.renderText("Best Time: " + std::to_string(bestTime) + " sec", 400, 250);
         mCardRenderer.renderText("Fewest Moves: " + std::to_string(bestMoves), 400, 300);
         for (auto &b : mStatisticsButtons)
-            b.render(mRenderer, mFont);
+            b.render(mRenderer, mCardRenderer.textCache());
     }
-    else if (state == PLAYING)
+    else if (state == REPLAY)
     {
-        for (const auto &pile : mGame.piles)
+        renderSettledBoard(mReplay.game(), mReplayLayout);
+        mCardRenderer.flushBatch();
+        mCardRenderer.renderText("Replay of deal #" + std::to_string(mReplay.seed()), 10, 735);
+        mCardRenderer.renderText("Move " + std::to_string(mReplay.position()) + " / " +
+                                     std::to_string(mReplay.length()), 800, 10);
+        mCardRenderer.renderText("Score: " + std::to_string(mReplay.game().score), 800, 30);
+        // scrub bar: click anywhere on it to jump there
+        SDL_Rect bar{REPLAY_BAR_X, REPLAY_BAR_Y, REPLAY_BAR_W, REPLAY_BAR_H};
+        SDL_SetRenderDrawColor(mRenderer, 50, 50, 50, 255);
+        SDL_RenderFillRect(mRenderer, &bar);
+        if (mReplay.length() > 0)
         {
-            SDL_Rect pileRect{pile.x, pile.y, CARD_WIDTH, CARD_HEIGHT};
-            SDL_SetRenderDrawColor(mRenderer, 50, 50, 50, 255);
-            SDL_RenderDrawRect(mRenderer, &pileRect);
-            int offset = (pile.type == TABLEAU) ? CARD_SPACING_Y : 0;
-            for (size_t i = 0; i < pile.cards.size(); i++)
-            {
-                int cardX = pile.x;
-                int cardY = pile.y + i * offset;
-                mCardRenderer.drawCard(cardX, cardY, pile.cards[i]);
-            }
+            bar.w = REPLAY_BAR_W * mReplay.position() / mReplay.length();
+            SDL_SetRenderDrawColor(mRenderer, 220, 220, 220, 255);
+            SDL_RenderFillRect(mRenderer, &bar);
         }
-        if (dragState.dragging)
-        {
-            int drawX = dragState.mouseX - dragState.offsetX;
-            int drawY = dragState.mouseY - dragState.offsetY;
-            for (size_t i = 0; i < dragState.draggedCards.size(); i++)
-                mCardRenderer.drawCard(drawX, drawY + i * CARD_SPACING_Y, dragState.draggedCards[i]);
-        }
-        updateAnimations(mCardRenderer);
-        mCardRenderer.renderText("Score: " + std::to_string(mGame.score), 800, 10);
-        mCardRenderer.renderText("Moves: " + std::to_string(mGame.moveCount), 800, 30);
-        mCardRenderer.renderText("Time: " + std::to_string((SDL_GetTicks() - mStartTime) / 1000) + " sec", 800, 50);
+        for (auto &button : mReplayButtons)
+            button.render(mRenderer, mCardRenderer.textCache());
+    }
+    else if (state == PLAYING)
+    {
+        // settled piles come from the board cache and cards in flight go
+        // on top in one batch; the dragged stack is drawn last of all
+        renderSettledBoard(mView, mLayout);
+        mDrawnHash = mView.hash;
+        mAnimations.draw(SDL_GetTicks(), mCardRenderer);
+        mCardRenderer.flushBatch();
+        mCascade.render(SDL_GetTicks(), mCardRenderer);
+        mCardRenderer.renderText("Score: " + std::to_string(mView.score), 800, 10);
+        mCardRenderer.renderText("Moves: " + std::to_string(mView.moveCount), 800, 30);
+        mShownSecond = (SDL_GetTicks() - mStartTime) / 1000;
+        mCardRenderer.renderText("Time: " + std::to_string(mShownSecond) + " sec", 800, 50);
         mCardRenderer.renderText("Draw Count: " + std::to_string(mDrawCount), 800, 70);
         mCardRenderer.renderText("High Score: " + std::to_string(highScore), 800, 90);
         // draw winning or random mode.
-        if (mGame.mode == WINNING)
+        if (mMode == WINNING)
             mCardRenderer.renderText("WINNING MODE", 800, 110);
         else
             mCardRenderer.renderText("RANDOM MODE", 800, 110);
+        std::string deal = "Deal #" + std::to_string(mView.seed);
+        DealRecord record = dealRecord();
+        if (record.status == DealStatus::Winnable)
+            deal += " - solution found in " + std::to_string(record.moves) + " moves";
+        else if (record.status == DealStatus::Unwinnable)
+            deal += " - unwinnable";
+        mCardRenderer.renderText(deal, 10, 735);
 
+        if (!win)
+            renderWinnability();
         if (win)
             mCardRenderer.renderText("YOU WIN!", 450, 350);
         else if (paused)
             mCardRenderer.renderText("PAUSED", 450, 350);
+        else if (gameDead())
+            mCardRenderer.renderText("Probably stuck - press E to end the game", 300, 410);
         // If hint is active, draw red outline for 2 sec.
         if (hintActive)
         {
             Uint32 elapsed = SDL_GetTicks() - hintStartTime;
-            if (elapsed < 2000)
+            if (elapsed < HINT_MS)
             {
-                Pile &hintPileRef = mGame.piles[hintPileIndex];
-                int hx = hintPileRef.x;
-                int hy = hintPileRef.y;
-                if (hintPileRef.type == TABLEAU)
-                    hy += hintCardIndex * CARD_SPACING_Y;
-                SDL_Rect hintRect = {hx - 2, hy - 2, CARD_WIDTH + 4, CARD_HEIGHT + 4};
+                PileOrigin ho = layout().cardPos(hintPileIndex, hintCardIndex);
+                SDL_Rect hintRect = {ho.x - 2, ho.y - 2, CARD_WIDTH + 4, CARD_HEIGHT + 4};
                 SDL_SetRenderDrawColor(mRenderer, 255, 0, 0, 255);
                 SDL_RenderDrawRect(mRenderer, &hintRect);
             }
@@ -277,14 +617,115 @@ void GameEngine::render()
                 hintActive = false;
             }
         }
+        if (!hintMessage.empty())
+        {
+            if (SDL_GetTicks() - hintStartTime < HINT_MS)
+                mCardRenderer.renderText(hintMessage, 450, 380);
+            else
+                hintMessage.clear();
+        }
+        if (mShowLatency && mDragLatency.samples() > 0)
+        {
+            int frame = (1000 + FRAME_HZ - 1) / FRAME_HZ;
+            mCardRenderer.renderText("Drag latency p50 " + std::to_string(mDragLatency.percentile(0.5)) +
+                                         " ms, p99 " + std::to_string(mDragLatency.percentile(0.99)) + " ms, " +
+                                         std::to_string(int(mDragLatency.within(frame) * 100)) + "% within a frame",
+                                     10, 705);
+        }
         for (auto &button : mPlayingButtons)
-            button.render(mRenderer, mFont);
+            button.render(mRenderer, mCardRenderer.textCache());
     }
+#ifdef SOLITAIRE_PROFILE
+    if (mShowProfiler)
+        renderProfiler();
+#endif
+    if (state == PLAYING && dragState.dragging)
+        renderDraggedStack();
+}
+
+#ifdef SOLITAIRE_PROFILE
+// F1 toggles this; F2 writes the Chrome trace
+void GameEngine::renderProfiler()
+{
+    const Profiler &p = Profiler::instance();
+    char line[96];
+    std::snprintf(line, sizeof line, "Frame p50 %.2f ms  p99 %.2f ms", p.frameMs(0.5), p.frameMs(0.99));
+    mCardRenderer.renderText(line, 10, 600);
+    std::snprintf(line, sizeof line, "Draw calls %d  Texture uploads %d",
+                  p.lastFrameCount(PROFILE_DRAW_CALLS), p.lastFrameCount(PROFILE_TEXTURE_UPLOADS));
+    mCardRenderer.renderText(line, 10, 625);
+    const TextCache &text = mCardRenderer.textCache();
+    std::snprintf(line, sizeof line, "Text cache %llu hits  %llu misses  %zu entries",
+                  (unsigned long long)text.hits(), (unsigned long long)text.misses(), text.size());
+    mCardRenderer.renderText(line, 10, 650);
+}
+#endif
+
+// Between the waste and the foundations
+void GameEngine::renderWinnability()
+{
+    static const char *const LABELS[] = {"Thinking...", "Can still win", "Cannot win", "Undecided"};
+    static const SDL_Color COLORS[] = {{200, 200, 200, 255}, {120, 255, 120, 255},
+                                       {255, 110, 110, 255}, {200, 200, 200, 255}};
+    int i = int(mWinnability);
+    mCardRenderer.textCache().draw(LABELS[i], 220, 90, COLORS[i]);
+}
+
+// Drawn last, at the pointer position read just before the frame is
+// presented, so the stack is at most one frame behind the cursor
+void GameEngine::renderDraggedStack()
+{
+    SDL_PumpEvents();
+    SDL_GetMouseState(&dragState.mouseX, &dragState.mouseY);
+    int drawX = dragState.mouseX - dragState.offsetX;
+    int drawY = dragState.mouseY - dragState.offsetY;
+    mCardRenderer.beginBatch();
+    for (size_t i = 0; i < dragState.draggedCards.size(); i++)
+        mCardRenderer.drawCard(drawX, drawY + i * CARD_SPACING_Y, dragState.draggedCards[i]);
+    mCardRenderer.flushBatch();
+}
+
+void GameEngine::framePresented()
+{
+    if (mMotionPending)
+        mDragLatency.add(SDL_GetTicks() - mMotionSince);
+    mMotionPending = false;
 }
 
 void GameEngine::handleEvent(SDL_Event &event)
 {
-    const int tableauYOffset = CARD_SPACING_Y;
+    PROFILE_SCOPE("GameEngine::handleEvent");
+    // any input may change hover states or the board
+    mNeedsRender = true;
+#ifdef SOLITAIRE_PROFILE
+    if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F1)
+    {
+        mShowProfiler = !mShowProfiler;
+        return;
+    }
+    if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F2)
+    {
+        if (Profiler::instance().writeChromeTrace(PROFILE_TRACE_FILE))
+            std::cerr << "Profile trace written to " << PROFILE_TRACE_FILE << "\n";
+        return;
+    }
+#endif
+    if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET)
+    {
+        if (event.type == SDL_RENDER_DEVICE_RESET)
+        {
+            // every texture lost its pixels, the card art included
+            mCardRenderer.textCache().clear();
+            SDL_Texture *textures[TEXTURE_COUNT] = {};
+            loadCardTextures(mRenderer, mBundle, textures);
+            mCardRenderer.replaceTextures(textures);
+        }
+        else
+            mCardRenderer.rebuildAtlas();
+        mBoardCache.invalidate();
+        mCascade.resetTrails();
+        return;
+    }
     if (state == MENU)
     {
 
@@ -331,6 +772,38 @@ void GameEngine::handleEvent(SDL_Event &event)
             }
         }
     }
+    else if (state == REPLAY)
+    {
+        if (event.type == SDL_QUIT)
+            mQuit = true;
+        else if (event.type == SDL_MOUSEBUTTONDOWN && event.button.button == SDL_BUTTON_LEFT)
+        {
+            int mx = event.button.x, my = event.button.y;
+            for (auto &button : mReplayButtons)
+            {
+                if (button.isClicked(mx, my))
+                {
+                    button.onClick();
+                    return;
+                }
+            }
+            if (pointInRect(mx, my, REPLAY_BAR_X, REPLAY_BAR_Y, REPLAY_BAR_W, REPLAY_BAR_H))
+                mReplay.seek((mx - REPLAY_BAR_X) * mReplay.length() / REPLAY_BAR_W);
+        }
+        else if (event.type == SDL_KEYDOWN)
+        {
+            switch (event.key.keysym.sym)
+            {
+            case SDLK_RIGHT:    mReplay.step(1); break;
+            case SDLK_LEFT:     mReplay.step(-1); break;
+            case SDLK_PAGEDOWN: mReplay.step(10); break;
+            case SDLK_PAGEUP:   mReplay.step(-10); break;
+            case SDLK_HOME:     mReplay.seek(0); break;
+            case SDLK_END:      mReplay.seek(mReplay.length()); break;
+            case SDLK_ESCAPE:   state = MENU; break;
+            }
+        }
+    }
     else if (state == PLAYING)
     {
         if (event.type == SDL_MOUSEBUTTONDOWN && event.button.button == SDL_BUTTON_LEFT)
@@ -357,7 +830,7 @@ void GameEngine::handleEvent(SDL_Event &event)
             {
                 if (event.key.keysym.sym == SDLK_w)
                 {
-                    mGame.mode = (mGame.mode == RANDOM) ? WINNING : RANDOM;
+                    mMode = (mMode == RANDOM) ? WINNING : RANDOM;
                     startNewGame();
                 }
                 if (event.key.keysym.sym == SDLK_d)
@@ -366,11 +839,11 @@ void GameEngine::handleEvent(SDL_Event &event)
                 }
                 if (event.key.keysym.sym == SDLK_u)
                 {
-                    if (undoStack.size() > 1)
-                    {
-                        undoStack.pop();
-                        mGame = undoStack.top();
-                    }
+                    undoMove();
+                }
+                if (event.key.keysym.sym == SDLK_y)
+                {
+                    redoMove();
                 }
                 if (event.key.keysym.sym == SDLK_r)
                 {
@@ -378,14 +851,15 @@ void GameEngine::handleEvent(SDL_Event &event)
                 }
                 if (event.key.keysym.sym == SDLK_h)
                 {
-                    int hp, hc, dest;
-                    if (findHint(hp, hc, dest))
-                    {
-                        hintPileIndex = hp;
-                        hintCardIndex = hc;
-                        hintStartTime = SDL_GetTicks();
-                        hintActive = true;
-                    }
+                    showHint();
+                }
+                if (event.key.keysym.sym == SDLK_l)
+                {
+                    mShowLatency = !mShowLatency;
+                }
+                if (event.key.keysym.sym == SDLK_e && gameDead())
+                {
+                    endGame();
                 }
                 if (event.key.keysym.sym == SDLK_a)
                 {
@@ -397,196 +871,97 @@ void GameEngine::handleEvent(SDL_Event &event)
         case SDL_MOUSEBUTTONDOWN:
             if (paused)
                 break;
-            if (event.button.button == SDL_BUTTON_LEFT)
+            // clicks wait for a new deal to reach the board
+            if (event.button.button == SDL_BUTTON_LEFT && boardSynced())
             {
                 int mx = event.button.x, my = event.button.y;
-                if (event.button.clicks > 1)
+                int hitPile = -1, hitCard = -1;
+                refreshView();
+                if (!layout().hitTest(mx, my, hitPile, hitCard))
+                    break;
+                // Double-click sends the top card of the waste or a column home.
+                if (event.button.clicks > 1 && hitCard >= 0 &&
+                    (hitPile == WASTE_PILE || hitPile >= FIRST_TABLEAU) && mInFlight[hitPile] == 0)
                 {
-                    // Check Waste.
-                    Pile &waste = mGame.piles[1];
-                    int cardIndex;
-                    if (!waste.cards.empty() && pointInRect(mx, my, waste.x, waste.y, CARD_WIDTH, CARD_HEIGHT) &&
-                        findCardAtPoint(waste, mx, my, cardIndex, 0))
-                    {
-                        if (waste.cards[cardIndex].faceUp)
-                        {
-                            int destIndex = -1;
-                            for (int i = 2; i < 6; i++)
-                            {
-                                if (mGame.canPlaceOnFoundation(waste.cards[cardIndex], mGame.piles[i]))
-                                {
-                                    destIndex = i;
-                                    break;
-                                }
-                            }
-                            if (destIndex != -1)
-                            {
-                                int srcX = mGame.piles[1].x;
-                                int srcY = mGame.piles[1].y;
-                                int destX = mGame.piles[destIndex].x;
-                                int destY = mGame.piles[destIndex].y;
-                                animateAutoMove(1, cardIndex, destIndex, srcX, srcY, destX, destY);
-                                return;
-                            }
-                        }
-                    }
-                    // Check Tableaus.
-                    for (int i = 6; i < mGame.piles.size(); i++)
+                    const Pile &pile = mView.piles[hitPile];
+                    if (pile.cards[hitCard].faceUp && hitCard == (int)pile.cards.size() - 1)
                     {
-                        Pile &pile = mGame.piles[i];
-                        int cardIndex;
-                        if (!pile.cards.empty() && findCardAtPoint(pile, mx, my, cardIndex, tableauYOffset))
+                        int destIndex = foundationFor(mView, pile.cards[hitCard]);
+                        if (destIndex != -1)
                         {
-                            if (pile.cards[cardIndex].faceUp)
-                            {
-                                int destIndex = -1;
-                                for (int j = 2; j < 6; j++)
-                                {
-                                    if (mGame.canPlaceOnFoundation(pile.cards[cardIndex], mGame.piles[j]))
-                                    {
-                                        destIndex = j;
-                                        break;
-                                    }
-                                }
-                                if (destIndex != -1)
-                                {
-                                    int srcX = pile.x;
-                                    int srcY = pile.y + cardIndex * tableauYOffset;
-                                    int destX = mGame.piles[destIndex].x;
-                                    int destY = mGame.piles[destIndex].y;
-                                    animateAutoMove(i, cardIndex, destIndex, srcX, srcY, destX, destY);
-                                    return;
-                                }
-                            }
+                            animateAutoMove(hitPile, hitCard, destIndex);
+                            return;
                         }
                     }
                 }
                 // Click on Stock.
-                if (pointInRect(mx, my, mGame.piles[0].x, mGame.piles[0].y, CARD_WIDTH, CARD_HEIGHT))
+                if (hitPile == STOCK_PILE)
                 {
-                    mGame.handleStockClick(mDrawCount);
-                    undoStack.push(mGame);
+                    Move m{};
+                    if (mInFlight[WASTE_PILE] == 0 && mView.stockMove(mDrawCount, m))
+                        postMove(m);
                     return;
                 }
-                // Click on Waste for dragging.
-                Pile &waste = mGame.piles[1];
-                if (!waste.cards.empty() && pointInRect(mx, my, waste.x, waste.y, CARD_WIDTH, CARD_HEIGHT))
+                // Drag the waste's top card, or a face-up run off a column.
+                if (hitCard >= 0 && (hitPile == WASTE_PILE || hitPile >= FIRST_TABLEAU) &&
+                    mInFlight[hitPile] == 0)
                 {
+                    const Pile &pile = mView.piles[hitPile];
+                    if (hitPile == WASTE_PILE)
+                        hitCard = (int)pile.cards.size() - 1;
+                    if (!pile.cards[hitCard].faceUp)
+                        break;
+                    PileOrigin at = mLayout.cardPos(hitPile, hitCard);
                     dragState.dragging = true;
                     dragState.draggedCards.clear();
-                    dragState.draggedCards.push_back(waste.cards.back());
-                    waste.cards.pop_back();
-                    dragState.originPileIndex = 1;
-                    dragState.originCardIndex = waste.cards.size();
-                    dragState.offsetX = mx - waste.x;
-                    dragState.offsetY = my - waste.y;
-                    dragState.mouseX = event.motion.x;
-                    dragState.mouseY = event.motion.y;
+                    for (int k = hitCard; k < (int)pile.cards.size(); k++)
+                        dragState.draggedCards.push_back(pile.cards[k]);
+                    dragState.originPileIndex = hitPile;
+                    dragState.originCardIndex = hitCard;
+                    dragState.offsetX = mx - at.x;
+                    dragState.offsetY = my - at.y;
+                    dragState.mouseX = mx;
+                    dragState.mouseY = my;
+                    refreshView();
                     return;
                 }
-                // Click on Tableaus.
-                for (int i = 6; i < mGame.piles.size(); i++)
-                {
-                    Pile &pile = mGame.piles[i];
-                    if (pile.type == TABLEAU && !pile.cards.empty())
-                    {
-                        int cardIndex = -1;
-                        if (findCardAtPoint(pile, mx, my, cardIndex, tableauYOffset))
-                        {
-                            if (pile.cards[cardIndex].faceUp)
-                            {
-                                dragState.dragging = true;
-                                dragState.draggedCards.clear();
-                                for (size_t k = cardIndex; k < pile.cards.size(); k++)
-                                    dragState.draggedCards.push_back(pile.cards[k]);
-                                pile.cards.erase(pile.cards.begin() + cardIndex, pile.cards.end());
-
-                                dragState.originPileIndex = i;
-                                dragState.originCardIndex = cardIndex;
-                                dragState.offsetX = mx - pile.x;
-                                dragState.offsetY = my - (pile.y + cardIndex * tableauYOffset);
-                                dragState.mouseX = event.motion.x;
-                                dragState.mouseY = event.motion.y;
-                                return;
-                            }
-                        }
-                    }
-                }
             }
             break;
         case SDL_MOUSEMOTION:
-            if (dragState.dragging)
+            // motion is coalesced: the stack is placed from the pointer
+            // position at render time, this only starts the latency clock
+            if (dragState.dragging && !mMotionPending)
             {
-                dragState.mouseX = event.motion.x;
-                dragState.mouseY = event.motion.y;
+                mMotionPending = true;
+                mMotionSince = event.motion.timestamp;
             }
             break;
         case SDL_MOUSEBUTTONUP:
             if (dragState.dragging)
             {
                 int mx = event.button.x, my = event.button.y;
-                bool placed = false;
+                int placedOn = -1;
+                int origin = dragState.originPileIndex;
+                int n = (int)dragState.draggedCards.size();
 
-                // --- 3a) Try Foundations if single card ---
-                if (dragState.draggedCards.size() == 1)
-                {
-                    Card c = dragState.draggedCards[0];
-                    for (int f = 2; f < 6; ++f)
-                    {
-                        Pile &dest = mGame.piles[f];
-                        if (pointInRect(mx, my, dest.x, dest.y, CARD_WIDTH, CARD_HEIGHT) &&
-                            mGame.canPlaceOnFoundation(c, dest))
-                        {
-                            dest.cards.push_back(c);
-                            mGame.moveCount++;
-                            placed = true;
-                            break;
-                        }
-                    }
-                }
+                // put the stack back, then send the drop as a move
+                dragState.dragging = false;
+                refreshView();
 
-                // --- 3b) Then your existing tableau logic ---
-                if (!placed)
+                // --- 3a) Try Foundations, then the tableau under the pointer ---
+                const BoardLayout &L = layout();
+                for (int i = FIRST_FOUNDATION; i < PILE_COUNT && placedOn < 0; ++i)
                 {
-                    for (int i = 6; i < (int)mGame.piles.size(); ++i)
-                    {
-                        Pile &dest = mGame.piles[i];
-                        if (dest.type != TABLEAU)
-                            continue;
-                        int dropX = dest.x;
-                        int dropY = dest.y + dest.cards.size() * CARD_SPACING_Y;
-                        if (pointInRect(mx, my, dropX, dropY, CARD_WIDTH, CARD_HEIGHT) &&
-                            canMoveSequence(dragState.draggedCards, dest))
-                        {
-                            dest.cards.insert(dest.cards.end(),
-                                              dragState.draggedCards.begin(),
-                                              dragState.draggedCards.end());
-                            mGame.moveCount++;
-                            placed = true;
-                            break;
-                        }
-                    }
+                    PileOrigin to = L.cardPos(i, L.pileSize(i));
+                    if (pointInRect(mx, my, to.x, to.y, CARD_WIDTH, CARD_HEIGHT) &&
+                        isLegalMove(mView, mDrawCount, makeMove(MOVE_CARDS, origin, i, n)))
+                        placedOn = i;
                 }
-
-                // --- flip underneath only if placed ---
-                if (placed)
+                if (placedOn >= 0)
                 {
-                    auto &orig = mGame.piles[dragState.originPileIndex];
-                    if (!orig.cards.empty() && !orig.cards.back().faceUp)
-                        orig.cards.back().faceUp = true;
+                    postMove(makeMove(MOVE_CARDS, origin, placedOn, n));
                     mSoundManager.playMoveSound();
                 }
-                else
-                {
-                    // bounce back
-                    auto &orig = mGame.piles[dragState.originPileIndex];
-                    orig.cards.insert(orig.cards.end(),
-                                      dragState.draggedCards.begin(),
-                                      dragState.draggedCards.end());
-                }
-
-                dragState.dragging = false;
-                undoStack.push(mGame);
             }
             break;
         }
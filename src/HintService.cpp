@@ -0,0 +1,107 @@
+// src/HintService.cpp
+#include "../include/HintService.h"
+#include "../include/Bot.h"
+#include "../include/MoveGen.h"
+#include <chrono>
+#include <climits>
+#include <utility>
+
+namespace {
+
+using Clock=std::chrono::steady_clock;
+
+// A card home is worth more than one turned over; each ply costs a little
+// so the shorter of two equal lines wins
+constexpr int HOME_VALUE=20, FACE_DOWN_COST=8, EMPTY_COLUMN_VALUE=4, PLY_COST=1;
+
+int evaluate(const Game& g){
+  int v=0;
+  for(int f=FIRST_FOUNDATION;f<FIRST_TABLEAU;++f) v+=HOME_VALUE*int(g.piles[f].cards.size());
+  for(int t=FIRST_TABLEAU;t<PILE_COUNT;++t){
+    const CardStack& col=g.piles[t].cards;
+    if(col.empty()){ v+=EMPTY_COLUMN_VALUE; continue; }
+    for(Card c:col) if(!c.faceUp) v-=FACE_DOWN_COST;
+  }
+  return v;
+}
+
+struct Search {
+  int drawCount;
+  Clock::time_point deadline;
+  const std::atomic<bool>* cancel;
+  uint64_t nodes=0;
+  bool stopped=false;
+  bool checkStop(){
+    if((++nodes&255)==0 &&
+       (Clock::now()>=deadline || (cancel && cancel->load(std::memory_order_relaxed))))
+      stopped=true;
+    return stopped;
+  }
+};
+
+// Best evaluation reachable from `g` within `depth` plies
+int lookahead(Game& g,int depth,Search& s){
+  int best=evaluate(g);
+  if(depth==0 || s.checkStop()) return best;
+  MoveList moves;
+  generateMoves(g,s.drawCount,moves);
+  for(Move m:moves){
+    if(rankMove(g,m)<0) continue;
+    g.applyMove(m);
+    int v=lookahead(g,depth-1,s)-PLY_COST;
+    g.undoMove(m);
+    if(v>best) best=v;
+    if(s.stopped) break;
+  }
+  return best;
+}
+
+} // namespace
+
+bool searchHint(const Game& root,int drawCount,uint32_t budgetMs,HintResult& out,
+                int maxDepth,const std::atomic<bool>* cancel){
+  Game g=root;
+  MoveList moves;
+  generateMoves(g,drawCount,moves);
+  int base=evaluate(g);
+  Search s{drawCount,Clock::now()+std::chrono::milliseconds(budgetMs),cancel};
+  bool found=false;
+  for(int depth=1;depth<=maxDepth;++depth){
+    int best=INT_MIN, bestRank=-1;
+    Move bestMove{};
+    for(Move m:moves){
+      int r=rankMove(g,m);
+      if(r<0) continue;
+      g.applyMove(m);
+      int v=lookahead(g,depth-1,s)-PLY_COST;
+      g.undoMove(m);
+      // on a tie the move that helps most right now
+      if(v>best || (v==best && r>bestRank)){ best=v; bestRank=r; bestMove=m; }
+      // the first ply always finishes, so there is always an answer
+      if(s.stopped && depth>1) break;
+    }
+    if(best==INT_MIN) return false;
+    if(s.stopped && depth>1) break;
+    out.move=bestMove;
+    out.gain=best-base;
+    out.depth=depth;
+    found=true;
+    if(s.stopped) break;
+  }
+  return found;
+}
+
+HintService::HintService(uint32_t budgetMs,std::function<void()> onReady)
+  :mBudgetMs(budgetMs),
+   mWorker([this](const Game& g,int draw,const std::atomic<bool>& cancel,Answer& a){
+     a.found=searchHint(g,draw,mBudgetMs,a.result,6,&cancel);
+     return true;
+   },std::move(onReady)){}
+
+bool HintService::lookup(const Game& g,int drawCount,bool& found,HintResult& out){
+  Answer a;
+  if(!mWorker.lookup(g,drawCount,a)) return false;
+  found=a.found;
+  out=a.result;
+  return true;
+}
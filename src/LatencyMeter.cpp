@@ -0,0 +1,25 @@
+// src/LatencyMeter.cpp
+#include "../include/LatencyMeter.h"
+#include <algorithm>
+
+void LatencyMeter::add(uint32_t ms){
+  mSamples[mNext]=ms;
+  mNext=(mNext+1)%WINDOW;
+  if(mCount<WINDOW) ++mCount;
+}
+
+uint32_t LatencyMeter::percentile(double q) const {
+  if(mCount==0) return 0;
+  uint32_t sorted[WINDOW];
+  std::copy(mSamples,mSamples+mCount,sorted);
+  int k=std::min(mCount-1,int(q*double(mCount-1)+0.5));
+  std::nth_element(sorted,sorted+k,sorted+mCount);
+  return sorted[k];
+}
+
+double LatencyMeter::within(uint32_t ms) const {
+  if(mCount==0) return 1;
+  int n=0;
+  for(int i=0;i<mCount;++i) if(mSamples[i]<=ms) ++n;
+  return double(n)/double(mCount);
+}
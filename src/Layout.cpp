@@ -0,0 +1,76 @@
+// src/Layout.cpp
+#include "../include/Layout.h"
+#include "../include/Game.h"
+#include <algorithm>
+#include <cstring>
+
+static_assert(PILE_COUNT==13, "BoardLayout is sized for 13 piles");
+
+PileOrigin pileOrigin(int i){
+  if(i==STOCK_PILE) return {50,50};
+  if(i==WASTE_PILE) return {130,50};
+  if(i<FIRST_TABLEAU) return {400+(i-FIRST_FOUNDATION)*(CARD_WIDTH+20),50};
+  return {50+(i-FIRST_TABLEAU)*(CARD_WIDTH+20),200};
+}
+
+namespace {
+// Only tableau columns fan out downwards
+int spacing(int pile){ return pile>=FIRST_TABLEAU ? CARD_SPACING_Y : 0; }
+}
+
+void BoardLayout::update(const Game& g){
+  bool same=mValid;
+  for(int p=0;p<PILE_COUNT && same;++p) same=mSize[p]==g.piles[p].cards.size();
+  if(same) return;
+  for(int p=0;p<PILE_COUNT;++p) mSize[p]=uint8_t(g.piles[p].cards.size());
+  rebuild();
+}
+
+void BoardLayout::rebuild(){
+  mValid=true;
+  int slot=0;
+  for(int p=0;p<PILE_COUNT;++p){
+    mStart[p]=uint8_t(slot);
+    PileOrigin o=pileOrigin(p);
+    for(int i=0;i<=mSize[p];++i) mPos[slot++]=PileOrigin{o.x,o.y+i*spacing(p)};
+  }
+  mStart[PILE_COUNT]=uint8_t(slot);
+
+  std::memset(mCells,0,sizeof mCells);
+  for(int p=0;p<PILE_COUNT;++p){
+    PileOrigin o=pileOrigin(p);
+    int last=std::max(0,mSize[p]-1);
+    // inclusive edges, as pointInRect
+    int x0=std::max(0,o.x/CELL), x1=std::min(GRID_W-1,(o.x+CARD_WIDTH)/CELL);
+    int y0=std::max(0,o.y/CELL), y1=std::min(GRID_H-1,(o.y+last*spacing(p)+CARD_HEIGHT)/CELL);
+    for(int cy=y0;cy<=y1;++cy)
+      for(int cx=x0;cx<=x1;++cx){
+        uint8_t* cell=mCells[cy][cx];
+        for(int k=0;k<CELL_PILES;++k)
+          if(!cell[k]){ cell[k]=uint8_t(p+1); break; }
+      }
+  }
+}
+
+PileOrigin BoardLayout::cardPos(int pile,int card) const {
+  card=std::min(std::max(card,0),int(mSize[pile]));
+  return mPos[mStart[pile]+card];
+}
+
+bool BoardLayout::hitTest(int x,int y,int& pile,int& card) const {
+  if(x<0 || y<0 || x>=WINDOW_WIDTH || y>=WINDOW_HEIGHT) return false;
+  const uint8_t* cell=mCells[y/CELL][x/CELL];
+  for(int k=0;k<CELL_PILES && cell[k];++k){
+    int p=cell[k]-1;
+    PileOrigin o=pileOrigin(p);
+    if(x<o.x || x>o.x+CARD_WIDTH || y<o.y) continue;
+    int n=mSize[p];
+    // the topmost card whose top edge is above y
+    int i=n==0 ? 0 : spacing(p) ? std::min(n-1,(y-o.y)/spacing(p)) : n-1;
+    if(y>o.y+i*spacing(p)+CARD_HEIGHT) continue;
+    pile=p;
+    card=n==0 ? -1 : i;
+    return true;
+  }
+  return false;
+}
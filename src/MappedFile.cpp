@@ -0,0 +1,56 @@
+// src/MappedFile.cpp
+#include "../include/MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+
+bool MappedFile::open(const char* path){
+  close();
+  HANDLE f=CreateFileA(path,GENERIC_READ,FILE_SHARE_READ,nullptr,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,nullptr);
+  if(f==INVALID_HANDLE_VALUE) return false;
+  LARGE_INTEGER sz;
+  if(!GetFileSizeEx(f,&sz) || sz.QuadPart==0){ CloseHandle(f); return false; }
+  HANDLE m=CreateFileMappingA(f,nullptr,PAGE_READONLY,0,0,nullptr);
+  if(!m){ CloseHandle(f); return false; }
+  void* p=MapViewOfFile(m,FILE_MAP_READ,0,0,0);
+  if(!p){ CloseHandle(m); CloseHandle(f); return false; }
+  mFile=f; mMapping=m;
+  mData=static_cast<const unsigned char*>(p);
+  mSize=size_t(sz.QuadPart);
+  return true;
+}
+
+void MappedFile::close(){
+  if(mData) UnmapViewOfFile(mData);
+  if(mMapping) CloseHandle(mMapping);
+  if(mFile) CloseHandle(mFile);
+  mData=nullptr; mSize=0; mFile=nullptr; mMapping=nullptr;
+}
+
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+bool MappedFile::open(const char* path){
+  close();
+  int fd=::open(path,O_RDONLY);
+  if(fd<0) return false;
+  struct stat st;
+  if(fstat(fd,&st)!=0 || st.st_size==0){ ::close(fd); return false; }
+  void* p=mmap(nullptr,size_t(st.st_size),PROT_READ,MAP_SHARED,fd,0);
+  ::close(fd); // the mapping keeps the file alive
+  if(p==MAP_FAILED) return false;
+  mData=static_cast<const unsigned char*>(p);
+  mSize=size_t(st.st_size);
+  return true;
+}
+
+void MappedFile::close(){
+  if(mData) munmap(const_cast<unsigned char*>(mData),mSize);
+  mData=nullptr; mSize=0;
+}
+#endif
+
+MappedFile::~MappedFile(){ close(); }
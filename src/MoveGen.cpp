@@ -0,0 +1,105 @@
+// src/MoveGen.cpp
+#include "../include/MoveGen.h"
+
+bool canMoveSequence(const CardStack& seq,const Pile& p){
+  for(size_t i=1;i<seq.size();++i)
+    if(!canStackOn(seq[i],seq[i-1])) return false;
+  return canPlaceOnTableau(seq.front(),p);
+}
+
+int foundationFor(const Game& g,Card c){
+  for(int f=FIRST_FOUNDATION;f<FIRST_TABLEAU;++f)
+    if(canPlaceOnFoundation(c,g.piles[f])) return f;
+  return -1;
+}
+
+namespace {
+
+// Destinations by what they accept: bit t-FIRST_TABLEAU of
+// accepts[value][red] is set when column t takes a card of that value and
+// colour, and home[suit] is the foundation building that suit. Built once
+// per call, so each source card costs a table read instead of a pile scan.
+struct TargetIndex {
+  uint8_t accepts[14][2]{};
+  int8_t  home[4] = {-1,-1,-1,-1};
+  uint8_t next[4] = {1,1,1,1};
+  uint8_t emptyHomes = 0;
+  TargetIndex(const Game& g){
+    for(int f=FIRST_FOUNDATION;f<FIRST_TABLEAU;++f){
+      const CardStack& cs=g.piles[f].cards;
+      if(cs.empty()){ emptyHomes|=uint8_t(1u<<(f-FIRST_FOUNDATION)); continue; }
+      home[cs.back().suit]=int8_t(f);
+      next[cs.back().suit]=uint8_t(cs.back().value+1);
+    }
+    for(int t=FIRST_TABLEAU;t<PILE_COUNT;++t){
+      const CardStack& cs=g.piles[t].cards;
+      uint8_t bit=uint8_t(1u<<(t-FIRST_TABLEAU));
+      if(cs.empty()){ accepts[13][0]|=bit; accepts[13][1]|=bit; continue; }
+      Card top=cs.back();
+      if(top.faceUp && top.value>1) accepts[top.value-1][!isRedSuit(top.suit)]|=bit;
+    }
+  }
+  void emitHome(Card c,int src,MoveList& out) const {
+    if(c.value!=next[c.suit]) return;
+    if(c.value>1){ out.add(makeMove(MOVE_CARDS,src,home[c.suit],1)); return; }
+    for(int f=0;f<4;++f)
+      if(emptyHomes>>f&1) out.add(makeMove(MOVE_CARDS,src,FIRST_FOUNDATION+f,1));
+  }
+  void emit(Card c,int src,int count,MoveList& out) const {
+    unsigned mask=accepts[c.value][isRedSuit(c.suit)];
+    if(src>=FIRST_TABLEAU) mask&=~(1u<<(src-FIRST_TABLEAU));
+    for(int d=FIRST_TABLEAU;mask;++d,mask>>=1)
+      if(mask&1) out.add(makeMove(MOVE_CARDS,src,d,count));
+  }
+};
+
+} // namespace
+
+void generateMoves(const Game& g,int drawCount,MoveList& out){
+  out.clear();
+  TargetIndex index(g);
+  const CardStack& waste=g.piles[WASTE_PILE].cards;
+  if(!waste.empty()){
+    index.emitHome(waste.back(),WASTE_PILE,out);
+    index.emit(waste.back(),WASTE_PILE,1,out);
+  }
+  for(int t=FIRST_TABLEAU;t<PILE_COUNT;++t){
+    const CardStack& cs=g.piles[t].cards;
+    int n=int(cs.size());
+    if(n==0) continue;
+    index.emitHome(cs.back(),t,out);
+    // walk up the face-up run from the top; every prefix is a movable stack
+    for(int k=n-1;k>=0 && cs[k].faceUp;--k){
+      index.emit(cs[k],t,n-k,out);
+      if(k>0 && !(cs[k-1].faceUp && canStackOn(cs[k],cs[k-1]))) break;
+    }
+  }
+  for(int f=FIRST_FOUNDATION;f<FIRST_TABLEAU;++f){
+    const CardStack& cs=g.piles[f].cards;
+    if(!cs.empty()) index.emit(cs.back(),f,1,out);
+  }
+  Move m{};
+  if(g.stockMove(drawCount,m)) out.add(m);
+}
+
+bool isLegalMove(const Game& g,int drawCount,const Move& m){
+  if(m.kind!=MOVE_CARDS){
+    Move s{};
+    return g.stockMove(drawCount,s) && s.kind==m.kind && s.count==m.count;
+  }
+  if(m.from>=PILE_COUNT || m.to>=PILE_COUNT || m.from==m.to || m.count==0) return false;
+  const Pile& src=g.piles[m.from];
+  const Pile& dst=g.piles[m.to];
+  int n=int(src.cards.size());
+  if(src.type==STOCK || m.count>n) return false;
+  if(src.type==FOUNDATION && dst.type!=TABLEAU) return false;
+  if(src.type!=TABLEAU && m.count!=1) return false;
+  int base=n-m.count;
+  for(int i=base;i<n;++i){
+    if(!src.cards[i].faceUp) return false;
+    if(i>base && !canStackOn(src.cards[i],src.cards[i-1])) return false;
+  }
+  if(dst.type==FOUNDATION) return m.count==1 && canPlaceOnFoundation(src.cards[base],dst);
+  if(dst.type==TABLEAU) return canPlaceOnTableau(src.cards[base],dst);
+  return false;
+}
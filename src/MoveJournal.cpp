@@ -0,0 +1,17 @@
+// src/MoveJournal.cpp
+#include "../include/MoveJournal.h"
+
+void MoveJournal::record(const Move& m){
+  mMoves.resize(mCursor);
+  mMoves.push_back(m);
+  ++mCursor;
+}
+
+bool MoveJournal::canUndo() const { return mCursor>0; }
+bool MoveJournal::canRedo() const { return mCursor<mMoves.size(); }
+
+const Move& MoveJournal::undo(){ return mMoves[--mCursor]; }
+const Move& MoveJournal::redo(){ return mMoves[mCursor++]; }
+
+void MoveJournal::clear(){ mMoves.clear(); mCursor=0; }
+size_t MoveJournal::size() const { return mCursor; }
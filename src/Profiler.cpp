@@ -0,0 +1,91 @@
+// src/Profiler.cpp
+#include "../include/Profiler.h"
+
+#ifdef SOLITAIRE_PROFILE
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace {
+uint64_t clockNs(){
+  return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+const char* const COUNTER_NAMES[PROFILE_COUNTER_COUNT]={"draw_calls","texture_uploads"};
+}
+
+Profiler& Profiler::instance(){
+  static Profiler p;
+  return p;
+}
+
+// both rings are allocated up front so recording never allocates
+Profiler::Profiler():mEpoch(clockNs()),mEvents(MAX_EVENTS),mFrames(MAX_FRAMES){}
+
+uint64_t Profiler::now() const { return clockNs()-mEpoch; }
+
+void Profiler::record(const char* name,uint64_t start,uint64_t end){
+  mEvents[mEventCount++%MAX_EVENTS]=Event{name,start,end};
+}
+
+void Profiler::beginFrame(){
+  mFrameStart=now();
+  std::fill(mCounters,mCounters+PROFILE_COUNTER_COUNT,0);
+}
+
+void Profiler::endFrame(){
+  Frame& f=mFrames[mFrameCount++%MAX_FRAMES];
+  f.start=mFrameStart;
+  f.end=now();
+  std::copy(mCounters,mCounters+PROFILE_COUNTER_COUNT,f.counters);
+}
+
+double Profiler::frameMs(double q) const {
+  int n=int(std::min<uint64_t>(mFrameCount,STATS_FRAMES));
+  if(n==0) return 0;
+  double ms[STATS_FRAMES];
+  for(int i=0;i<n;++i){
+    const Frame& f=mFrames[(mFrameCount-1-i)%MAX_FRAMES];
+    ms[i]=double(f.end-f.start)*1e-6;
+  }
+  int k=std::min(n-1,int(q*double(n-1)+0.5));
+  std::nth_element(ms,ms+k,ms+n);
+  return ms[k];
+}
+
+int Profiler::lastFrameCount(ProfileCounter c) const {
+  return mFrameCount ? mFrames[(mFrameCount-1)%MAX_FRAMES].counters[c] : 0;
+}
+
+bool Profiler::writeChromeTrace(const char* path) const {
+  FILE* out=std::fopen(path,"w");
+  if(!out) return false;
+  std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n",out);
+  bool first=true;
+  auto sep=[&]{ std::fputs(first?"":",\n",out); first=false; };
+  // rings are written oldest first; timestamps are microseconds
+  uint64_t e0=mEventCount>MAX_EVENTS ? mEventCount-MAX_EVENTS : 0;
+  for(uint64_t i=e0;i<mEventCount;++i){
+    const Event& e=mEvents[i%MAX_EVENTS];
+    sep();
+    std::fprintf(out,"{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}",
+                 e.name,double(e.start)*1e-3,double(e.end-e.start)*1e-3);
+  }
+  uint64_t f0=mFrameCount>MAX_FRAMES ? mFrameCount-MAX_FRAMES : 0;
+  for(uint64_t i=f0;i<mFrameCount;++i){
+    const Frame& f=mFrames[i%MAX_FRAMES];
+    sep();
+    std::fprintf(out,"{\"name\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":%.3f,\"dur\":%.3f}",
+                 double(f.start)*1e-3,double(f.end-f.start)*1e-3);
+    for(int c=0;c<PROFILE_COUNTER_COUNT;++c){
+      sep();
+      std::fprintf(out,"{\"name\":\"%s\",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"args\":{\"count\":%d}}",
+                   COUNTER_NAMES[c],double(f.end)*1e-3,f.counters[c]);
+    }
+  }
+  std::fputs("\n]}\n",out);
+  return std::fclose(out)==0;
+}
+
+#endif
@@ -0,0 +1,45 @@
+// src/RenderBatch.cpp
+#include "../include/RenderBatch.h"
+
+void RenderBatch::begin(SDL_Texture* tex,int w,int h){
+  mTexture=tex;
+  mInvW=1.f/float(w);
+  mInvH=1.f/float(h);
+  clear();
+}
+
+void RenderBatch::clear(){
+  mVertices.clear();
+  mIndices.clear();
+  mSrc.clear();
+  mDst.clear();
+}
+
+void RenderBatch::add(const SDL_Rect& s,const SDL_Rect& d){
+  const SDL_Color white{255,255,255,255};
+  float u0=s.x*mInvW, v0=s.y*mInvH, u1=(s.x+s.w)*mInvW, v1=(s.y+s.h)*mInvH;
+  float x0=float(d.x), y0=float(d.y), x1=float(d.x+d.w), y1=float(d.y+d.h);
+  int base=int(mVertices.size());
+  mVertices.push_back({{x0,y0},white,{u0,v0}});
+  mVertices.push_back({{x1,y0},white,{u1,v0}});
+  mVertices.push_back({{x1,y1},white,{u1,v1}});
+  mVertices.push_back({{x0,y1},white,{u0,v1}});
+  for(int i:{0,1,2,0,2,3}) mIndices.push_back(base+i);
+  mSrc.push_back(s);
+  mDst.push_back(d);
+}
+
+int RenderBatch::flush(SDL_Renderer* R){
+  int calls=0;
+  if(!mVertices.empty()){
+    calls=1;
+    if(SDL_RenderGeometry(R,mTexture,mVertices.data(),int(mVertices.size()),
+                          mIndices.data(),int(mIndices.size()))<0){
+      // a backend whose SDL_RenderGeometry fails at runtime; building needs SDL 2.0.18+
+      for(size_t i=0;i<mSrc.size();++i) SDL_RenderCopy(R,mTexture,&mSrc[i],&mDst[i]);
+      calls=int(mSrc.size());
+    }
+  }
+  clear();
+  return calls;
+}
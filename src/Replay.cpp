@@ -0,0 +1,163 @@
+// src/Replay.cpp
+#include "../include/Replay.h"
+#include "../include/MappedFile.h"
+#include "../include/MoveGen.h"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+const char    REPLAY_MAGIC[4]={'S','R','P','L'};
+const uint8_t REPLAY_VERSION=1;
+
+void putVarint(std::vector<uint8_t>& out,uint64_t v){
+  while(v>=0x80){ out.push_back(uint8_t(v|0x80)); v>>=7; }
+  out.push_back(uint8_t(v));
+}
+
+struct Reader {
+  const uint8_t* p;
+  const uint8_t* end;
+  bool ok=true;
+  uint64_t varint(){
+    uint64_t v=0;
+    for(int shift=0;shift<64;shift+=7){
+      if(p==end){ ok=false; return 0; }
+      uint8_t b=*p++;
+      v|=uint64_t(b&0x7F)<<shift;
+      if(!(b&0x80)) return v;
+    }
+    ok=false;
+    return 0;
+  }
+};
+
+uint64_t zigzag(int64_t v){ return (uint64_t(v)<<1)^uint64_t(v>>63); }
+int64_t  unzigzag(uint64_t v){ return int64_t(v>>1)^-int64_t(v&1); }
+
+void putKeyframe(std::vector<uint8_t>& out,const Game& g){
+  for(const Pile& p:g.piles){
+    out.push_back(uint8_t(p.cards.size()));
+    for(Card c:p.cards){ uint8_t b; std::memcpy(&b,&c,1); out.push_back(b); }
+  }
+  putVarint(out,zigzag(g.score));
+  putVarint(out,uint64_t(g.moveCount));
+}
+
+bool readKeyframe(Reader& in,Game& g){
+  int total=0;
+  for(Pile& p:g.piles){
+    uint64_t n=in.varint();
+    if(!in.ok || n>PILE_CAPACITY || uint64_t(in.end-in.p)<n) return false;
+    p.cards.clear();
+    for(uint64_t i=0;i<n;++i){
+      Card c; std::memcpy(&c,in.p++,1);
+      if(c.value<1 || c.value>13) return false;
+      p.cards.push_back(c);
+    }
+    total+=int(n);
+  }
+  g.score=int(unzigzag(in.varint()));
+  g.moveCount=int(in.varint());
+  g.hash=g.computeHash();
+  return in.ok && total==52;
+}
+
+// Recordings don't say which draw count was in effect, so a stock move
+// is accepted if either setting would have produced it
+bool legalRecorded(const Game& g,const Move& m){
+  return isLegalMove(g,1,m) || (m.kind==MOVE_DRAW && isLegalMove(g,3,m));
+}
+
+Game dealt(uint64_t seed){
+  Game g;
+  g.initializeDeck(seed);
+  g.setupPiles();
+  return g;
+}
+
+} // namespace
+
+std::vector<uint8_t> encodeReplay(const Replay& r,int keyframeInterval){
+  std::vector<uint8_t> out(REPLAY_MAGIC,REPLAY_MAGIC+4);
+  out.push_back(REPLAY_VERSION);
+  putVarint(out,r.seed);
+  putVarint(out,uint64_t(keyframeInterval));
+  putVarint(out,r.moves.size());
+  for(const Move& m:r.moves){
+    // stock moves always go between the same two piles: one byte
+    if(m.kind==MOVE_CARDS)
+      putVarint(out,uint64_t(m.kind) | uint64_t(m.from)<<2 | uint64_t(m.to)<<6 | uint64_t(m.count)<<10);
+    else
+      putVarint(out,uint64_t(m.kind) | uint64_t(m.count)<<2);
+  }
+  Game g=dealt(r.seed);
+  for(size_t i=0;i<r.moves.size();++i){
+    Move m=r.moves[i];
+    g.applyMove(m);
+    if((i+1)%size_t(keyframeInterval)==0) putKeyframe(out,g);
+  }
+  return out;
+}
+
+bool saveReplay(const char* path,const std::vector<uint8_t>& bytes){
+  FILE* f=std::fopen(path,"wb");
+  if(!f) return false;
+  bool ok=std::fwrite(bytes.data(),1,bytes.size(),f)==bytes.size();
+  return std::fclose(f)==0 && ok;
+}
+
+bool ReplayPlayer::load(const uint8_t* data,size_t size){
+  Reader in{data,data+size};
+  if(size<5 || std::memcmp(data,REPLAY_MAGIC,4)!=0 || data[4]!=REPLAY_VERSION) return false;
+  in.p+=5;
+  uint64_t seed=in.varint();
+  uint64_t interval=in.varint();
+  uint64_t count=in.varint();
+  // every move takes at least one byte, which bounds a corrupt count
+  if(!in.ok || interval==0 || interval>0xFFFF || count>uint64_t(in.end-in.p)) return false;
+
+  std::vector<Move> moves(count);
+  for(Move& m:moves){
+    uint64_t v=in.varint();
+    if((v&3)==MOVE_DRAW) m=makeMove(MOVE_DRAW,STOCK_PILE,WASTE_PILE,int(v>>2&31));
+    else if((v&3)==MOVE_RECYCLE) m=makeMove(MOVE_RECYCLE,WASTE_PILE,STOCK_PILE,int(v>>2&31));
+    else m=makeMove(MoveKind(v&3),int(v>>2&15),int(v>>6&15),int(v>>10&31));
+    if(!in.ok || m.kind>MOVE_CARDS || m.from>=PILE_COUNT || m.to>=PILE_COUNT) return false;
+  }
+  std::vector<Game> keyframes(1,dealt(seed));
+  for(uint64_t k=1;k<=count/interval;++k){
+    keyframes.push_back(keyframes[0]);
+    if(!readKeyframe(in,keyframes.back())) return false;
+  }
+
+  mSeed=seed;
+  mInterval=int(interval);
+  mMoves.swap(moves);
+  mKeyframes.swap(keyframes);
+  mGame=mKeyframes[0];
+  mPos=0;
+  return true;
+}
+
+bool ReplayPlayer::load(const char* path){
+  MappedFile f;
+  return f.open(path) && load(f.data(),f.size());
+}
+
+bool ReplayPlayer::seek(int moveIndex){
+  if(moveIndex<0) moveIndex=0;
+  if(moveIndex>length()) moveIndex=length();
+  // step forward from where we are when that is no further than a keyframe
+  if(moveIndex<mPos || moveIndex-mPos>=mInterval){
+    int k=moveIndex/mInterval;
+    mGame=mKeyframes[k];
+    mPos=k*mInterval;
+  }
+  for(;mPos<moveIndex;++mPos){
+    Move m=mMoves[mPos];
+    if(!legalRecorded(mGame,m)) return false;
+    mGame.applyMove(m);
+  }
+  return true;
+}
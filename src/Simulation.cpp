@@ -0,0 +1,132 @@
+// src/Simulation.cpp
+#include "../include/Simulation.h"
+#include "../include/MoveGen.h"
+#include "../include/Replay.h"
+#include "../include/Solver.h"
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <string>
+#include <utility>
+
+Simulation::Simulation(std::function<void()> onPublish):mOnPublish(std::move(onPublish)){
+  publish();
+  mThread=std::thread(&Simulation::run,this);
+}
+
+Simulation::~Simulation(){ stop(); }
+
+uint32_t Simulation::post(SimCommand c){
+  c.seq=mNextSeq;
+  if(!mCommands.push(c)) return 0;
+  ++mNextSeq;
+  // taking the lock orders the push before the rules thread's wait check
+  { std::lock_guard<std::mutex> lock(mWakeLock); }
+  mWake.notify_one();
+  return c.seq;
+}
+
+void Simulation::stop(){
+  if(!mThread.joinable()) return;
+  {
+    std::lock_guard<std::mutex> lock(mWakeLock);
+    mStopping=true;
+  }
+  mWake.notify_one();
+  mThread.join();
+  refresh();
+}
+
+void Simulation::run(){
+  using clock=std::chrono::steady_clock;
+  const auto tick=std::chrono::nanoseconds(1000000000/TICK_HZ);
+  auto next=clock::now();
+  for(;;){
+    {
+      std::unique_lock<std::mutex> lock(mWakeLock);
+      mWake.wait(lock,[&]{ return mStopping || !mCommands.empty(); });
+    }
+    if(!mStopping) std::this_thread::sleep_until(next);
+    SimCommand c;
+    while(mCommands.pop(c)) apply(c);
+    // a won game goes to disk straight away
+    if(isSolved(mGame)) saveReplay();
+    if(mStopping){
+      saveReplay();
+      publish();
+      return;
+    }
+    publish();
+    if(mOnPublish && !mStopping) mOnPublish();
+    next=clock::now()+tick;
+  }
+}
+
+void Simulation::apply(const SimCommand& c){
+  mAckSeq=c.seq;
+  switch(c.kind){
+  case SimCommandKind::NewGame:
+    saveReplay();
+    mGame=Game();
+    mGame.mode=c.mode;
+    mGame.initializeDeck(c.seed);
+    mGame.setupPiles();
+    mJournal.clear();
+    mStall.reset();
+    mReplaySaved=true;
+    break;
+  case SimCommandKind::Move: {
+    Move m=c.move;
+    if(!isLegalMove(mGame,c.drawCount,m)) break;
+    mGame.applyMove(m);
+    mJournal.record(m);
+    mStall.onMove(mGame,c.drawCount,m);
+    mReplaySaved=false;
+    break;
+  }
+  case SimCommandKind::Undo:
+    if(!mJournal.canUndo()) break;
+    mGame.undoMove(mJournal.undo());
+    // the detector only follows play forwards; start it afresh
+    mStall.reset();
+    mReplaySaved=false;
+    break;
+  case SimCommandKind::Redo: {
+    if(!mJournal.canRedo()) break;
+    Move m=mJournal.redo();
+    mGame.applyMove(m);
+    mStall.reset();
+    mReplaySaved=false;
+    break;
+  }
+  case SimCommandKind::SaveReplay:
+    saveReplay();
+    break;
+  }
+}
+
+void Simulation::publish(){
+  SimSnapshot& s=mSnapshots.back();
+  s.game=mGame;
+  s.ackSeq=mAckSeq;
+  s.won=isSolved(mGame);
+  s.dead=mStall.dead();
+  mSnapshots.publish();
+}
+
+// Writes the moves played so far as a replay file (and as the one the menu
+// opens). Games with no moves are not worth keeping.
+void Simulation::saveReplay(){
+  if(mReplaySaved || mJournal.size()==0) return;
+  Replay r;
+  r.seed=mGame.seed;
+  r.moves.assign(mJournal.begin(),mJournal.end());
+  std::vector<uint8_t> bytes=encodeReplay(r);
+  std::error_code ec;
+  std::filesystem::create_directories(REPLAY_DIR,ec);
+  std::string name=std::string(REPLAY_DIR)+"/deal-"+std::to_string(r.seed)+"-"+
+                   std::to_string((long long)std::time(nullptr))+".rpl";
+  ::saveReplay(name.c_str(),bytes);
+  ::saveReplay(REPLAY_LAST_FILE,bytes);
+  mReplaySaved=true;
+}
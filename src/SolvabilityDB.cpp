@@ -0,0 +1,79 @@
+// src/SolvabilityDB.cpp
+#include "../include/SolvabilityDB.h"
+#include <cstdio>
+#include <cstring>
+
+static const char DB_MAGIC[8]={'S','O','L','V','D','B','\0','\1'};
+
+namespace {
+
+// The file is little-endian; these convert a field to or from host order
+constexpr bool HOST_LITTLE_ENDIAN=__BYTE_ORDER__==__ORDER_LITTLE_ENDIAN__;
+uint16_t le16(uint16_t v){ return HOST_LITTLE_ENDIAN ? v : __builtin_bswap16(v); }
+uint32_t le32(uint32_t v){ return HOST_LITTLE_ENDIAN ? v : __builtin_bswap32(v); }
+uint64_t le64(uint64_t v){ return HOST_LITTLE_ENDIAN ? v : __builtin_bswap64(v); }
+
+} // namespace
+
+uint16_t packDealRecord(const DealRecord& r){
+  int moves=r.moves<MAX_RECORD_MOVES ? r.moves : MAX_RECORD_MOVES;
+  return uint16_t(int(r.status) | int(r.difficulty)<<2 | moves<<4);
+}
+
+DealRecord unpackDealRecord(uint16_t bits){
+  DealRecord r;
+  r.status=DealStatus(bits&3);
+  r.difficulty=Difficulty((bits>>2)&3);
+  r.moves=bits>>4;
+  return r;
+}
+
+bool writeSolvabilityDB(const char* path,int drawCount,uint64_t firstSeed,
+                        const std::vector<uint16_t>& records){
+  FILE* f=std::fopen(path,"wb");
+  if(!f) return false;
+  SolvabilityHeader h{};
+  std::memcpy(h.magic,DB_MAGIC,sizeof h.magic);
+  h.drawCount=le32(uint32_t(drawCount));
+  h.firstSeed=le64(firstSeed);
+  h.count=le64(records.size());
+  std::vector<uint16_t> swapped;
+  const uint16_t* out=records.data();
+  if(!HOST_LITTLE_ENDIAN){
+    swapped.reserve(records.size());
+    for(uint16_t r:records) swapped.push_back(le16(r));
+    out=swapped.data();
+  }
+  bool ok=std::fwrite(&h,sizeof h,1,f)==1 &&
+          std::fwrite(out,sizeof(uint16_t),records.size(),f)==records.size();
+  return std::fclose(f)==0 && ok;
+}
+
+bool SolvabilityDB::open(const char* path){
+  close();
+  if(!mFile.open(path)) return false;
+  auto* h=reinterpret_cast<const SolvabilityHeader*>(mFile.data());
+  if(mFile.size()<sizeof *h || std::memcmp(h->magic,DB_MAGIC,sizeof h->magic)!=0 ||
+     (mFile.size()-sizeof *h)/sizeof(uint16_t)<le64(h->count)){
+    mFile.close();
+    return false;
+  }
+  mDrawCount=int(le32(h->drawCount));
+  mFirstSeed=le64(h->firstSeed);
+  mCount=le64(h->count);
+  mRecords=reinterpret_cast<const uint16_t*>(mFile.data()+sizeof *h);
+  return true;
+}
+
+void SolvabilityDB::close(){
+  mFile.close();
+  mRecords=nullptr;
+  mDrawCount=0;
+  mFirstSeed=mCount=0;
+}
+
+bool SolvabilityDB::lookup(uint64_t seed,DealRecord& out) const {
+  if(!mRecords || seed<mFirstSeed || seed-mFirstSeed>=mCount) return false;
+  out=unpackDealRecord(le16(mRecords[seed-mFirstSeed]));
+  return true;
+}
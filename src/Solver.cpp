@@ -0,0 +1,454 @@
+// src/Solver.cpp
+#include "../include/Solver.h"
+#include "../include/MoveGen.h"
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+constexpr int MAX_STEPS = 512;
+
+// One search edge: `clicks` stock clicks followed by `play`. Drawing is only
+// ever useful to reach a card, and tableau moves commute with drawing, so
+// folding the clicks into the play that uses them loses no solutions.
+struct Step {
+  Move    play;
+  uint8_t clicks;
+};
+
+struct StepBuffer {
+  Step steps[MAX_STEPS];
+  int  count = 0;
+  void add(Move m,int clicks=0){ steps[count++] = Step{m,uint8_t(clicks)}; }
+};
+
+// Highest value on each suit's foundation (0 = none yet)
+void foundationTops(const Game& g,int tops[4]){
+  for(int s=0;s<4;++s) tops[s]=0;
+  for(int f=FIRST_FOUNDATION;f<FIRST_TABLEAU;++f){
+    auto& cs=g.piles[f].cards;
+    if(!cs.empty()) tops[cs.back().suit]=cs.back().value;
+  }
+}
+
+// A card nothing else could ever need on the tableau: every card that
+// could be built on it, or on the cards built on that, is already home.
+bool safeToFoundation(const Card& c,const int tops[4]){
+  if(c.value<=2) return true;
+  for(int s=0;s<4;++s){
+    if(s==c.suit) continue;
+    int need=(isRedSuit(s)==isRedSuit(c.suit)) ? c.value-2 : c.value-1;
+    if(tops[s]<need) return false;
+  }
+  return true;
+}
+
+int firstFaceUp(const CardStack& cs){
+  int i=int(cs.size());
+  while(i>0 && cs[i-1].faceUp) --i;
+  return i;
+}
+
+// Steps in the order worth trying them. A safe foundation move dominates
+// everything else, so when one exists it is the only step returned.
+void generateSteps(const Game& g,int drawCount,StepBuffer& out){
+  int tops[4];
+  foundationTops(g,tops);
+  const CardStack& waste=g.piles[WASTE_PILE].cards;
+
+  // 1. foundation moves
+  if(!waste.empty()){
+    int f=foundationFor(g,waste.back());
+    if(f>=0){
+      if(safeToFoundation(waste.back(),tops)){ out.count=0; out.add(makeMove(MOVE_CARDS,WASTE_PILE,f,1)); return; }
+      out.add(makeMove(MOVE_CARDS,WASTE_PILE,f,1));
+    }
+  }
+  for(int t=FIRST_TABLEAU;t<PILE_COUNT;++t){
+    auto& cs=g.piles[t].cards;
+    if(cs.empty()) continue;
+    int f=foundationFor(g,cs.back());
+    if(f<0) continue;
+    if(safeToFoundation(cs.back(),tops)){ out.count=0; out.add(makeMove(MOVE_CARDS,t,f,1)); return; }
+    out.add(makeMove(MOVE_CARDS,t,f,1));
+  }
+
+  // Empty columns are interchangeable; only ever target the first one
+  int firstEmpty=-1;
+  for(int t=FIRST_TABLEAU;t<PILE_COUNT;++t)
+    if(g.piles[t].cards.empty()){ firstEmpty=t; break; }
+  auto targets=[&](const Card& c,int src,auto&& emit){
+    for(int d=FIRST_TABLEAU;d<PILE_COUNT;++d){
+      if(d==src) continue;
+      if(g.piles[d].cards.empty() && d!=firstEmpty) continue;
+      if(canPlaceOnTableau(c,g.piles[d])) emit(d);
+    }
+  };
+
+  // 2. whole face-up runs that turn a card over or clear a column
+  for(int t=FIRST_TABLEAU;t<PILE_COUNT;++t){
+    auto& cs=g.piles[t].cards;
+    if(cs.empty()) continue;
+    int k=firstFaceUp(cs);
+    int n=int(cs.size())-k;
+    targets(cs[k],t,[&](int d){
+      // a column-bottom king moving to an empty column changes nothing
+      if(k==0 && g.piles[d].cards.empty()) return;
+      out.add(makeMove(MOVE_CARDS,t,d,n));
+    });
+  }
+
+  // 3. waste to tableau
+  if(!waste.empty())
+    targets(waste.back(),WASTE_PILE,[&](int d){ out.add(makeMove(MOVE_CARDS,WASTE_PILE,d,1)); });
+
+  // 4. cards further down the stock, one full cycle round. The talon reads
+  // as waste bottom-to-top then stock top-to-bottom; `pos` cards of it are
+  // in the waste, so the waste top after any number of clicks is talon[pos-1].
+  const CardStack& stock=g.piles[STOCK_PILE].cards;
+  int w=int(waste.size()), n=w+int(stock.size());
+  auto talon=[&](int i){ return i<w ? waste[i] : stock[n-1-i]; };
+  int pos=w, recycles=0;
+  for(int clicks=1;n>0;++clicks){
+    if(pos==n){
+      // a draw-3 cycle need not line up with where it started; two
+      // recycles have shown every reachable waste top
+      if(++recycles==2) break;
+      pos=0;
+    } else {
+      pos=std::min(pos+drawCount,n);
+    }
+    if(pos==w) break;
+    if(pos==0) continue;
+    Card c=talon(pos-1);
+    int f=foundationFor(g,c);
+    if(f>=0) out.add(makeMove(MOVE_CARDS,WASTE_PILE,f,1),clicks);
+    targets(c,WASTE_PILE,[&](int d){ out.add(makeMove(MOVE_CARDS,WASTE_PILE,d,1),clicks); });
+  }
+
+  // 5. partial runs
+  for(int t=FIRST_TABLEAU;t<PILE_COUNT;++t){
+    auto& cs=g.piles[t].cards;
+    for(int k=firstFaceUp(cs)+1;k<int(cs.size());++k){
+      int n=int(cs.size())-k;
+      targets(cs[k],t,[&](int d){ out.add(makeMove(MOVE_CARDS,t,d,n)); });
+    }
+  }
+
+  // 6. back off a foundation, unless the card is provably never needed
+  for(int f=FIRST_FOUNDATION;f<FIRST_TABLEAU;++f){
+    auto& cs=g.piles[f].cards;
+    if(cs.empty() || safeToFoundation(cs.back(),tops)) continue;
+    targets(cs.back(),f,[&](int d){ out.add(makeMove(MOVE_CARDS,f,d,1)); });
+  }
+}
+
+// Apply a step, appending its primitive moves to `path`
+void applyStep(Game& g,int drawCount,const Step& st,std::vector<Move>& path){
+  for(int i=0;i<st.clicks;++i){
+    Move m{};
+    g.stockMove(drawCount,m);
+    g.applyMove(m);
+    path.push_back(m);
+  }
+  Move m=st.play;
+  g.applyMove(m);
+  path.push_back(m);
+}
+
+void undoStep(Game& g,const Step& st,std::vector<Move>& path){
+  for(int i=0;i<=st.clicks;++i){
+    g.undoMove(path.back());
+    path.pop_back();
+  }
+}
+
+struct Frame {
+  StepBuffer buf;
+  int        next = 0;
+};
+
+// Builds may shrink it (-DSOLITAIRE_SOLVER_POLL_INTERVAL=1) so the parallel
+// solver splits work at nearly every node, as tools/solvercheck does
+#ifndef SOLITAIRE_SOLVER_POLL_INTERVAL
+#define SOLITAIRE_SOLVER_POLL_INTERVAL 1024
+#endif
+constexpr uint64_t POLL_INTERVAL = SOLITAIRE_SOLVER_POLL_INTERVAL;
+
+// Depth-first search from `g` over the frames already on `stack`, appending
+// the line being explored to `path`. Every POLL_INTERVAL nodes it asks
+// `poll(nodes)` whether to keep going; the parallel solver also uses that
+// hook to hand work to idle threads.
+template<class Poll>
+SolveStatus runSearch(Game& g,int drawCount,TranspositionTable& tt,
+                      std::vector<Frame>& stack,std::vector<Move>& path,
+                      uint64_t& nodes,Poll&& poll){
+  while(!stack.empty()){
+    Frame& f=stack.back();
+    if(f.next>=f.buf.count){
+      stack.pop_back();
+      if(!stack.empty()){
+        Frame& parent=stack.back();
+        undoStep(g,parent.buf.steps[parent.next-1],path);
+      }
+      continue;
+    }
+    if(nodes%POLL_INTERVAL==0){
+      if(!poll(nodes)) return SolveStatus::Unknown;
+      // poll may have split off this frame's untried steps
+      if(f.next>=f.buf.count) continue;
+    }
+    const Step& st=f.buf.steps[f.next++];
+    applyStep(g,drawCount,st,path);
+    ++nodes;
+    if(isSolved(g)) return SolveStatus::Solved;
+    if(!tt.insert(g.hash)){ undoStep(g,st,path); continue; }
+    stack.emplace_back();
+    generateSteps(g,drawCount,stack.back().buf);
+  }
+  return SolveStatus::Unsolvable;
+}
+
+using Clock=std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point t){
+  return std::chrono::duration<double>(Clock::now()-t).count();
+}
+
+} // namespace
+
+bool isSolved(const Game& g){
+  for(int f=FIRST_FOUNDATION;f<FIRST_TABLEAU;++f)
+    if(g.piles[f].cards.size()!=13) return false;
+  return true;
+}
+
+Solver::Solver(int ttBits):mTable(ttBits){}
+
+void Solver::cancel(){ mCancel.store(true); }
+
+SolveResult Solver::solve(const Game& start,int drawCount,const SolverLimits& limits){
+  auto deadline=Clock::now()+std::chrono::milliseconds(limits.maxMillis);
+
+  SolveResult res;
+  mCancel.store(false);
+  if(isSolved(start)){ res.status=SolveStatus::Solved; return res; }
+
+  Game g=start;
+  mTable.clear();
+  mTable.insert(g.hash);
+
+  std::vector<Frame> stack(1);
+  generateSteps(g,drawCount,stack.back().buf);
+  res.status=runSearch(g,drawCount,mTable,stack,res.moves,res.nodes,[&](uint64_t nodes){
+    return nodes<limits.maxNodes && Clock::now()<deadline &&
+           !mCancel.load(std::memory_order_relaxed) &&
+           !(limits.stop && limits.stop->load(std::memory_order_relaxed));
+  });
+  if(res.status!=SolveStatus::Solved) res.moves.clear();
+  return res;
+}
+
+// ---------------------------------------------------------------------------
+// Parallel search
+
+namespace {
+
+// A subtree to search: the position, the moves that led to it from the
+// solve() root, and optionally the untried steps a busy thread split off.
+struct Task {
+  Game              root;
+  std::vector<Move> prefix;
+  StepBuffer        steps;
+  bool              hasSteps = false;
+};
+
+struct Worker {
+  std::mutex       lock;
+  std::deque<Task> tasks; // owner pops the back, thieves take the front
+  ThreadStats      stats;
+};
+
+struct Shared {
+  TranspositionTable&      table;
+  const std::atomic<bool>& cancel;
+  const SolverLimits&      limits;
+  int                      drawCount;
+  Clock::time_point        deadline;
+  std::vector<Worker>      workers;
+  std::atomic<int>         pending{0}; // tasks queued or running
+  std::atomic<int>         hungry{0};  // threads looking for work
+  std::atomic<uint64_t>    nodes{0};
+  std::atomic<bool>        stop{false};
+  std::atomic<bool>        outOfBudget{false};
+  std::mutex               resultLock;
+  std::vector<Move>        solution;
+  bool                     solved = false;
+
+  Shared(TranspositionTable& tt,const std::atomic<bool>& c,const SolverLimits& l,int draw,int threads)
+   : table(tt),cancel(c),limits(l),drawCount(draw),
+     deadline(Clock::now()+std::chrono::milliseconds(l.maxMillis)),
+     workers(threads){}
+};
+
+// Give the untried steps of the shallowest open frame to this worker's
+// queue, where an idle thread can steal them. Shallow frames hold the
+// largest subtrees, so one split keeps a thief busy for a long time.
+void split(Shared& sh,Worker& me,const Task& task,
+           std::vector<Frame>& stack,const std::vector<Move>& path){
+  {
+    std::lock_guard<std::mutex> lk(me.lock);
+    if(!me.tasks.empty()) return;
+  }
+  size_t depth=0, len=0;
+  for(;depth<stack.size();++depth){
+    const Frame& f=stack[depth];
+    if(f.next<f.buf.count) break;
+    len+=f.buf.steps[f.next-1].clicks+1;
+  }
+  if(depth==stack.size()) return;
+  Frame& f=stack[depth];
+
+  Task t;
+  t.root=task.root;
+  t.prefix=task.prefix;
+  for(size_t i=0;i<len;++i){
+    Move m=path[i];
+    t.root.applyMove(m);
+    t.prefix.push_back(m);
+  }
+  t.hasSteps=true;
+  for(int i=f.next;i<f.buf.count;++i) t.steps.add(f.buf.steps[i].play,f.buf.steps[i].clicks);
+  f.buf.count=f.next;
+
+  sh.pending.fetch_add(1);
+  std::lock_guard<std::mutex> lk(me.lock);
+  me.tasks.push_back(std::move(t));
+}
+
+void searchTask(Shared& sh,Worker& me,Task& task){
+  Game g=task.root;
+  std::vector<Frame> stack(1);
+  if(task.hasSteps) stack.back().buf=task.steps;
+  else generateSteps(g,sh.drawCount,stack.back().buf);
+  std::vector<Move> path;
+  uint64_t nodes=0, reported=0;
+
+  auto poll=[&](uint64_t n)->bool{
+    sh.nodes.fetch_add(n-reported,std::memory_order_relaxed);
+    reported=n;
+    if(sh.stop.load(std::memory_order_relaxed)) return false;
+    if(sh.cancel.load(std::memory_order_relaxed) ||
+       (sh.limits.stop && sh.limits.stop->load(std::memory_order_relaxed)) ||
+       sh.nodes.load(std::memory_order_relaxed)>=sh.limits.maxNodes ||
+       Clock::now()>=sh.deadline){
+      sh.outOfBudget=true;
+      sh.stop=true;
+      return false;
+    }
+    if(sh.hungry.load(std::memory_order_relaxed)>0) split(sh,me,task,stack,path);
+    return true;
+  };
+
+  SolveStatus st=runSearch(g,sh.drawCount,sh.table,stack,path,nodes,poll);
+  sh.nodes.fetch_add(nodes-reported,std::memory_order_relaxed);
+  me.stats.nodes+=nodes;
+  if(st==SolveStatus::Solved){
+    std::lock_guard<std::mutex> lk(sh.resultLock);
+    if(!sh.solved){
+      sh.solved=true;
+      sh.solution=task.prefix;
+      sh.solution.insert(sh.solution.end(),path.begin(),path.end());
+    }
+    sh.stop=true;
+  }
+}
+
+void workerLoop(Shared& sh,int self){
+  int threads=int(sh.workers.size());
+  Worker& me=sh.workers[self];
+  auto started=Clock::now();
+  bool wasHungry=false;
+
+  auto takeTask=[&](Task& out)->bool{
+    {
+      std::lock_guard<std::mutex> lk(me.lock);
+      if(!me.tasks.empty()){ out=std::move(me.tasks.back()); me.tasks.pop_back(); return true; }
+    }
+    for(int k=1;k<threads;++k){
+      Worker& victim=sh.workers[(self+k)%threads];
+      std::lock_guard<std::mutex> lk(victim.lock);
+      if(!victim.tasks.empty()){
+        out=std::move(victim.tasks.front()); victim.tasks.pop_front();
+        ++me.stats.steals;
+        return true;
+      }
+    }
+    return false;
+  };
+
+  while(!sh.stop.load(std::memory_order_relaxed) && sh.pending.load()>0){
+    Task task;
+    if(!takeTask(task)){
+      if(!wasHungry){ sh.hungry.fetch_add(1); wasHungry=true; }
+      std::this_thread::yield();
+      continue;
+    }
+    if(wasHungry){ sh.hungry.fetch_sub(1); wasHungry=false; }
+    auto t0=Clock::now();
+    searchTask(sh,me,task);
+    me.stats.busySeconds+=secondsSince(t0);
+    ++me.stats.tasks;
+    sh.pending.fetch_sub(1);
+  }
+  if(wasHungry) sh.hungry.fetch_sub(1);
+  me.stats.seconds=secondsSince(started);
+}
+
+} // namespace
+
+double ThreadStats::nodesPerSecond() const {
+  return seconds>0 ? double(nodes)/seconds : 0.0;
+}
+
+ParallelSolver::ParallelSolver(int threads,int ttBits)
+ : mThreads(threads>0 ? threads : int(std::max(1u,std::thread::hardware_concurrency()))),
+   mTable(ttBits){}
+
+void ParallelSolver::cancel(){ mCancel.store(true); }
+
+int ParallelSolver::threadCount() const { return mThreads; }
+
+SolveResult ParallelSolver::solve(const Game& start,int drawCount,const SolverLimits& limits){
+  SolveResult res;
+  mCancel.store(false);
+  if(isSolved(start)){ res.status=SolveStatus::Solved; return res; }
+
+  mTable.clear();
+  mTable.insert(start.hash);
+
+  Shared sh(mTable,mCancel,limits,drawCount,mThreads);
+  Task root;
+  root.root=start;
+  sh.workers[0].tasks.push_back(std::move(root));
+  sh.pending=1;
+
+  std::vector<std::thread> threads;
+  for(int i=0;i<mThreads;++i)
+    threads.emplace_back([&sh,i]{ workerLoop(sh,i); });
+  for(auto& t:threads) t.join();
+
+  for(auto& w:sh.workers){ res.nodes+=w.stats.nodes; res.threads.push_back(w.stats); }
+  if(sh.solved){
+    res.status=SolveStatus::Solved;
+    res.moves=std::move(sh.solution);
+  } else if(sh.outOfBudget){
+    res.status=SolveStatus::Unknown;
+  } else {
+    res.status=SolveStatus::Unsolvable;
+  }
+  return res;
+}
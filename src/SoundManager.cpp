@@ -3,10 +3,10 @@
 #include "../include/Constants.h"
 #include <iostream>
 
-SoundManager::SoundManager():soundOn(true){
+SoundManager::SoundManager(const unsigned char* wav,size_t size):soundOn(true){
   if(Mix_OpenAudio(44100,MIX_DEFAULT_FORMAT,2,2048)<0)
     std::cerr<<"SDL_mixer init error: "<<Mix_GetError()<<"\n";
-  moveSound=Mix_LoadWAV(MOVE_SOUND_FILE);
+  moveSound=wav ? Mix_LoadWAV_RW(SDL_RWFromConstMem(wav,int(size)),1) : Mix_LoadWAV(MOVE_SOUND_FILE);
   if(!moveSound) std::cerr<<"LoadWAV error: "<<Mix_GetError()<<"\n";
 }
 
@@ -0,0 +1,51 @@
+// src/StallDetector.cpp
+#include "../include/StallDetector.h"
+#include "../include/Bot.h"
+#include "../include/MoveGen.h"
+
+namespace {
+
+bool hasHome(const Game& g,Card c){
+  if(foundationFor(g,c)>=0) return true;
+  for(int t=FIRST_TABLEAU;t<PILE_COUNT;++t)
+    if(canPlaceOnTableau(c,g.piles[t])) return true;
+  return false;
+}
+
+// rankMove passes over moving part of a run, but doing so is progress
+// when the card it uncovers can then go home
+bool freesFoundationCard(const Game& g,const Move& m){
+  if(g.piles[m.from].type!=TABLEAU) return false;
+  const CardStack& src=g.piles[m.from].cards;
+  int base=int(src.size())-m.count;
+  return base>0 && foundationFor(g,src[base-1])>=0;
+}
+
+bool hasUsefulCardMove(const Game& g,int drawCount){
+  MoveList moves;
+  generateMoves(g,drawCount,moves);
+  for(const Move& m:moves)
+    if(m.kind==MOVE_CARDS && (rankMove(g,m)>=2 || freesFoundationCard(g,m))) return true;
+  return false;
+}
+
+} // namespace
+
+void StallDetector::onMove(const Game& g,int drawCount,const Move& m){
+  switch(m.kind){
+  case MOVE_DRAW:
+    if(hasHome(g,g.piles[WASTE_PILE].cards.back())) ++mPlayable;
+    break;
+  case MOVE_CARDS:
+    // the position has changed, so the next pass is a fresh one
+    mCycling=mDead=false;
+    break;
+  case MOVE_RECYCLE:
+    mCycling=g.hash==mPassStart;
+    mDead=mCycling && mPlayable==0 && !mBoardMoves;
+    mPassStart=g.hash;
+    mPlayable=0;
+    mBoardMoves=hasUsefulCardMove(g,drawCount);
+    break;
+  }
+}
@@ -0,0 +1,60 @@
+// src/TextCache.cpp
+#include "../include/TextCache.h"
+#include "../include/Profiler.h"
+
+TextCache::TextCache(SDL_Renderer* R,TTF_Font* F,size_t capacity)
+ : mRenderer(R),mFont(F),mCapacity(capacity){}
+
+TextCache::~TextCache(){ clear(); }
+
+void TextCache::clear(){
+  for(auto& e:mEntries) if(e.texture) SDL_DestroyTexture(e.texture);
+  mEntries.clear();
+  mIndex.clear();
+}
+
+const TextCache::Entry* TextCache::lookup(const std::string& text,SDL_Color c){
+  mKey.assign(reinterpret_cast<const char*>(&c),sizeof c);
+  mKey+=text;
+  auto it=mIndex.find(mKey);
+  if(it!=mIndex.end()){
+    ++mHits;
+    mEntries.splice(mEntries.begin(),mEntries,it->second);
+    return &mEntries.front();
+  }
+  ++mMisses;
+  PROFILE_COUNT(PROFILE_TEXTURE_UPLOADS,1);
+  SDL_Surface* s=TTF_RenderText_Blended(mFont,text.c_str(),c);
+  if(!s) return nullptr;
+  Entry e{mKey,SDL_CreateTextureFromSurface(mRenderer,s),s->w,s->h};
+  SDL_FreeSurface(s);
+  if(mIndex.size()>=mCapacity){
+    Entry& old=mEntries.back();
+    if(old.texture) SDL_DestroyTexture(old.texture);
+    mIndex.erase(old.key);
+    mEntries.pop_back();
+  }
+  mEntries.push_front(e);
+  mIndex.emplace(mKey,mEntries.begin());
+  return &mEntries.front();
+}
+
+void TextCache::draw(const std::string& text,int x,int y,SDL_Color c){
+  PROFILE_SCOPE("TextCache::draw");
+  if(text.empty()) return;
+  const Entry* e=lookup(text,c);
+  if(!e || !e->texture) return;
+  SDL_Rect d{x,y,e->w,e->h};
+  SDL_RenderCopy(mRenderer,e->texture,nullptr,&d);
+  PROFILE_COUNT(PROFILE_DRAW_CALLS,1);
+}
+
+void TextCache::drawCentered(const std::string& text,const SDL_Rect& box,SDL_Color c){
+  PROFILE_SCOPE("TextCache::drawCentered");
+  if(text.empty()) return;
+  const Entry* e=lookup(text,c);
+  if(!e || !e->texture) return;
+  SDL_Rect d{box.x+(box.w-e->w)/2,box.y+(box.h-e->h)/2,e->w,e->h};
+  SDL_RenderCopy(mRenderer,e->texture,nullptr,&d);
+  PROFILE_COUNT(PROFILE_DRAW_CALLS,1);
+}
@@ -0,0 +1,31 @@
+// src/TranspositionTable.cpp
+#include "../include/TranspositionTable.h"
+
+static constexpr int PROBE = 8;
+
+TranspositionTable::TranspositionTable(int bits)
+ : mSlots(new std::atomic<uint64_t>[size_t(1)<<bits]),mMask((uint64_t(1)<<bits)-1){
+  clear();
+}
+
+bool TranspositionTable::insert(uint64_t h){
+  if(h==0) h=1; // 0 marks an empty slot
+  uint64_t i=h&mMask;
+  for(int p=0;p<PROBE;++p){
+    std::atomic<uint64_t>& s=mSlots[(i+p)&mMask];
+    uint64_t cur=s.load(std::memory_order_relaxed);
+    if(cur==h) return false;
+    if(cur==0){
+      if(s.compare_exchange_strong(cur,h,std::memory_order_relaxed)) return true;
+      if(cur==h) return false; // another thread got there first
+    }
+  }
+  mSlots[i].store(h,std::memory_order_relaxed);
+  return true;
+}
+
+void TranspositionTable::clear(){
+  for(size_t i=0;i<=mMask;++i) mSlots[i].store(0,std::memory_order_relaxed);
+}
+
+size_t TranspositionTable::capacity() const { return size_t(mMask)+1; }
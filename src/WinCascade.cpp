@@ -0,0 +1,111 @@
+// src/WinCascade.cpp
+#include "../include/WinCascade.h"
+#include "../include/CardRenderer.h"
+#include "../include/Constants.h"
+#include "../include/Layout.h"
+#include "../include/Profiler.h"
+
+namespace {
+const float  GRAVITY     = 1800.f; // px/s^2
+const float  BOUNCE      = 0.75f;  // vertical speed kept on each bounce
+const Uint32 LAUNCH_MS   = 220;    // between launches
+const int    MAX_CATCHUP = 30;     // steps per frame before time is skipped
+const float  FLOOR_Y     = float(WINDOW_HEIGHT - CARD_HEIGHT);
+}
+
+WinCascade::WinCascade(SDL_Renderer* R):mRenderer(R){
+  if(SDL_RenderTargetSupported(R)){
+    mTrails=SDL_CreateTexture(R,SDL_PIXELFORMAT_RGBA8888,SDL_TEXTUREACCESS_TARGET,
+                              WINDOW_WIDTH,WINDOW_HEIGHT);
+    if(mTrails) SDL_SetTextureBlendMode(mTrails,SDL_BLENDMODE_BLEND);
+  }
+}
+
+WinCascade::~WinCascade(){ if(mTrails) SDL_DestroyTexture(mTrails); }
+
+void WinCascade::start(const Game& g,uint64_t seed,Uint32 now){
+  mQueued=0;
+  for(int v=13;v>=1;--v)
+    for(int f=FIRST_FOUNDATION;f<FIRST_TABLEAU;++f){
+      const CardStack& cs=g.piles[f].cards;
+      if(v<=(int)cs.size() && mQueued<MAX_CARDS){
+        mQueue[mQueued]=cs[v-1];
+        mQueuePile[mQueued++]=f;
+      }
+    }
+  mRng.seed(uint32_t(seed));
+  mLaunched=mLive=0;
+  mStart=now;
+  mSimulatedMs=0;
+  mClearTrails=true;
+  mActive=true;
+}
+
+void WinCascade::stop(){
+  mActive=false;
+  mLive=mQueued=mLaunched=0;
+}
+
+void WinCascade::launch(){
+  PileOrigin o=pileOrigin(mQueuePile[mLaunched]);
+  std::uniform_real_distribution<float> speed(140.f,420.f), lift(0.f,450.f);
+  int i=mLive++;
+  mX[i]=float(o.x);
+  mY[i]=float(o.y);
+  mVX[i]=(mRng()&1) ? speed(mRng) : -speed(mRng);
+  mVY[i]=-lift(mRng);
+  mCard[i]=mQueue[mLaunched++];
+}
+
+void WinCascade::step(float dt){
+  for(int i=0;i<mLive;++i){
+    mVY[i]+=GRAVITY*dt;
+    mX[i]+=mVX[i]*dt;
+    mY[i]+=mVY[i]*dt;
+    if(mY[i]>FLOOR_Y){ mY[i]=FLOOR_Y; mVY[i]=-mVY[i]*BOUNCE; }
+  }
+  // off either side: swap-remove
+  for(int i=0;i<mLive;){
+    if(mX[i]>-CARD_WIDTH && mX[i]<WINDOW_WIDTH){ ++i; continue; }
+    --mLive;
+    mX[i]=mX[mLive]; mY[i]=mY[mLive]; mVX[i]=mVX[mLive]; mVY[i]=mVY[mLive]; mCard[i]=mCard[mLive];
+  }
+}
+
+void WinCascade::render(Uint32 now,CardRenderer& cards){
+  if(!mActive) return;
+  PROFILE_SCOPE("WinCascade::render");
+  const Uint32 stepMs=1000/STEP_HZ;
+  const float  dt=1.f/float(STEP_HZ);
+  Uint32 elapsed=now-mStart;
+  if(elapsed-mSimulatedMs>MAX_CATCHUP*stepMs) mSimulatedMs=elapsed-MAX_CATCHUP*stepMs;
+
+  SDL_Texture* previous=nullptr;
+  if(mTrails){
+    previous=SDL_GetRenderTarget(mRenderer);
+    SDL_SetRenderTarget(mRenderer,mTrails);
+    if(mClearTrails){
+      SDL_SetRenderDrawColor(mRenderer,0,0,0,0);
+      SDL_RenderClear(mRenderer);
+      mClearTrails=false;
+    }
+    cards.beginBatch();
+  }
+  for(;mSimulatedMs+stepMs<=elapsed;mSimulatedMs+=stepMs){
+    while(mLaunched<mQueued && mLaunched*LAUNCH_MS<=mSimulatedMs && mLive<MAX_CARDS) launch();
+    step(dt);
+    if(mTrails)
+      for(int i=0;i<mLive;++i) cards.drawCard(int(mX[i]),int(mY[i]),mCard[i]);
+  }
+  if(mTrails){
+    cards.flushBatch();
+    SDL_SetRenderTarget(mRenderer,previous);
+    SDL_RenderCopy(mRenderer,mTrails,nullptr,nullptr);
+    PROFILE_COUNT(PROFILE_DRAW_CALLS,1);
+  } else {
+    // the latest positions are already in the trail; without one draw them
+    cards.beginBatch();
+    for(int i=0;i<mLive;++i) cards.drawCard(int(mX[i]),int(mY[i]),mCard[i]);
+    cards.flushBatch();
+  }
+}
@@ -0,0 +1,63 @@
+// src/WinnabilityMonitor.cpp
+#include "../include/WinnabilityMonitor.h"
+#include "../include/MoveGen.h"
+#include <utility>
+
+namespace {
+
+// `to` is one legal move on from `from`
+bool follows(const Game& from,int drawCount,const Game& to){
+  MoveList moves;
+  generateMoves(from,drawCount,moves);
+  Game g=from;
+  for(Move m:moves){
+    g.applyMove(m);
+    bool hit=g.hash==to.hash;
+    g.undoMove(m);
+    if(hit) return true;
+  }
+  return false;
+}
+
+} // namespace
+
+WinnabilityMonitor::WinnabilityMonitor(const SolverLimits& limits,std::function<void()> onReady)
+  :mLimits(limits),
+   mWorker([this](const Game& g,int draw,const std::atomic<bool>& stop,Winnability& w){
+     return analyze(g,draw,stop,w);
+   },std::move(onReady)){}
+
+Winnability WinnabilityMonitor::status(const Game& g,int drawCount){
+  Winnability w;
+  return mWorker.lookup(g,drawCount,w) ? w : Winnability::Analyzing;
+}
+
+bool WinnabilityMonitor::analyze(const Game& g,int drawCount,const std::atomic<bool>& stop,Winnability& out){
+  if(mLostDraw==drawCount && follows(mLost,drawCount,g)){
+    mLost=g;
+    out=Winnability::Lost;
+    return true;
+  }
+  SolverLimits limits=mLimits;
+  limits.stop=&stop;
+  SolveResult r=mSolver.solve(g,drawCount,limits);
+  if(r.status==SolveStatus::Unsolvable){
+    mLost=g;
+    mLostDraw=drawCount;
+    out=Winnability::Lost;
+    return true;
+  }
+  // a stopped solve has no answer; it is asked again if still wanted
+  if(r.status!=SolveStatus::Solved){
+    out=Winnability::Unknown;
+    return !stop;
+  }
+  // the rest of the line is a proof for every position along it
+  Game w=g;
+  for(Move m:r.moves){
+    w.applyMove(m);
+    mWorker.store(positionKey(w,drawCount),Winnability::Winnable);
+  }
+  out=Winnability::Winnable;
+  return true;
+}
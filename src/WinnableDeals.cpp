@@ -0,0 +1,40 @@
+// src/WinnableDeals.cpp
+// Generated by tools/dealgen; do not edit by hand.
+#include "../include/DealPool.h"
+
+const int BUILTIN_WINNABLE_COUNT = 16;
+
+static const uint64_t DRAW1_Easy[] = {
+  2u, 4u, 5u, 6u, 7u, 9u, 10u, 11u,
+  15u, 17u, 18u, 19u, 23u, 24u, 25u, 29u,
+};
+
+static const uint64_t DRAW1_Medium[] = {
+  3u, 13u, 31u, 60u, 61u, 84u, 94u, 95u,
+  98u, 103u, 134u, 138u, 182u, 189u, 195u, 211u,
+};
+
+static const uint64_t DRAW1_Hard[] = {
+  16u, 22u, 26u, 34u, 41u, 65u, 88u, 109u,
+  128u, 132u, 153u, 158u, 166u, 172u, 175u, 178u,
+};
+
+static const uint64_t DRAW3_Easy[] = {
+  2u, 5u, 10u, 11u, 19u, 24u, 25u, 29u,
+  32u, 40u, 43u, 46u, 49u, 51u, 54u, 55u,
+};
+
+static const uint64_t DRAW3_Medium[] = {
+  3u, 6u, 7u, 9u, 12u, 14u, 23u, 30u,
+  36u, 42u, 48u, 50u, 53u, 60u, 92u, 102u,
+};
+
+static const uint64_t DRAW3_Hard[] = {
+  4u, 21u, 22u, 26u, 33u, 41u, 84u, 95u,
+  97u, 98u, 111u, 116u, 128u, 136u, 141u, 149u,
+};
+
+const uint64_t* const BUILTIN_WINNABLE_DEALS[2][DIFFICULTY_COUNT] = {
+  { DRAW1_Easy, DRAW1_Medium, DRAW1_Hard },
+  { DRAW3_Easy, DRAW3_Medium, DRAW3_Hard },
+};
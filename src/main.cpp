@@ -5,8 +5,21 @@
 #include <iostream>
 #include "../include/Constants.h"
 #include "../include/GameEngine.h"
+#include "../include/FrameScheduler.h"
+#include "../include/Profiler.h"
+#include "../include/AssetLoader.h"
+
+namespace {
+// Startup stages go to stderr with the time since main() was entered
+Uint64 gLaunch=0;
+void logStartup(const char* stage){
+  double ms=double(SDL_GetPerformanceCounter()-gLaunch)*1000.0/double(SDL_GetPerformanceFrequency());
+  std::cerr<<"startup: "<<stage<<" at "<<ms<<" ms\n";
+}
+}
 
 int main(int argc,char*argv[]){
+  gLaunch=SDL_GetPerformanceCounter();
   if(SDL_Init(SDL_INIT_VIDEO|SDL_INIT_AUDIO)<0){
     std::cerr<<"SDL_Init: "<<SDL_GetError()<<"\n"; return 1;
   }
@@ -16,30 +29,56 @@ int main(int argc,char*argv[]){
   if(!(IMG_Init(IMG_INIT_PNG)&IMG_INIT_PNG)){
     std::cerr<<"IMG_Init: "<<IMG_GetError()<<"\n"; TTF_Quit(); SDL_Quit(); return 1;
   }
+  logStartup("SDL initialized");
 
   SDL_Window*   win=SDL_CreateWindow("Solitaire",
                       SDL_WINDOWPOS_CENTERED,SDL_WINDOWPOS_CENTERED,
                       WINDOW_WIDTH,WINDOW_HEIGHT,0);
   if(!win){ std::cerr<<"CreateWindow: "<<SDL_GetError()<<"\n"; IMG_Quit(); TTF_Quit(); SDL_Quit(); return 1; }
-  SDL_Renderer* ren=SDL_CreateRenderer(win,-1,SDL_RENDERER_ACCELERATED);
+  SDL_Renderer* ren=SDL_CreateRenderer(win,-1,SDL_RENDERER_ACCELERATED|SDL_RENDERER_TARGETTEXTURE);
   if(!ren){ std::cerr<<"CreateRenderer: "<<SDL_GetError()<<"\n"; SDL_DestroyWindow(win); IMG_Quit(); TTF_Quit(); SDL_Quit(); return 1; }
 
-  TTF_Font* font=TTF_OpenFont(FONT_FILE,FONT_SIZE);
-  if(!font){
-    std::cerr<<"OpenFont: "<<TTF_GetError()<<"\n"; SDL_DestroyRenderer(ren); SDL_DestroyWindow(win);
+  logStartup("window and renderer created");
+
+  StartupAssets assets;
+  if(!loadStartupAssets(ren,assets)){
+    SDL_DestroyRenderer(ren); SDL_DestroyWindow(win);
     IMG_Quit(); TTF_Quit(); SDL_Quit(); return 1;
   }
+  logStartup(assets.bundle.isOpen() ? "assets loaded from bundle" : "assets loaded from loose files");
+  TTF_Font* font=assets.font;
 
-  GameEngine engine(ren,font);
-  SDL_Event e;
-  while(!engine.quit()){
-    while(SDL_PollEvent(&e)) engine.handleEvent(e);
-    engine.update();
-    SDL_SetRenderDrawColor(ren,0,100,0,255);
-    SDL_RenderClear(ren);
-    engine.render();
-    SDL_RenderPresent(ren);
-    SDL_Delay(16);
+  // the engine's textures and threads go before the renderer does
+  {
+    GameEngine engine(ren,assets);
+    logStartup("engine ready");
+    FrameScheduler frames(ren);
+    bool firstFrame=true;
+    SDL_Event e;
+    while(!engine.quit()){
+      // sleep until input, the next timed update, or the next frame slot
+      bool woken=SDL_WaitEventTimeout(&e,frames.waitTimeout(engine.isAnimating(),engine.msUntilUpdate()));
+      PROFILE_FRAME_BEGIN(); // frame time leaves out the wait
+      if(woken){
+        engine.handleEvent(e);
+        while(SDL_PollEvent(&e)) engine.handleEvent(e);
+      }
+      engine.update();
+      // an idle board is not redrawn at all
+      if(engine.needsRender()){
+        SDL_SetRenderDrawColor(ren,TABLE_COLOR_R,TABLE_COLOR_G,TABLE_COLOR_B,255);
+        SDL_RenderClear(ren);
+        engine.render();
+        {
+          PROFILE_SCOPE("SDL_RenderPresent");
+          SDL_RenderPresent(ren);
+        }
+        PROFILE_FRAME_END();
+        if(firstFrame){ logStartup("first frame presented"); firstFrame=false; }
+        frames.framePresented();
+        engine.framePresented();
+      }
+    }
   }
 
   TTF_CloseFont(font);
@@ -0,0 +1,79 @@
+// tools/assetpack.cpp
+// Packs the game's textures (decoded to RGBA), font and sound into one
+// asset bundle, read at startup with a single mmap:
+//   ./assetpack [out-file]      (default: assets.sab, next to the game)
+// Run it from the directory holding textures/, fonts/ and sounds/.
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <cstdio>
+#include <iostream>
+#include "../include/AssetBundle.h"
+#include "../include/Constants.h"
+
+namespace {
+
+bool readFile(const char* path,std::vector<unsigned char>& out){
+  FILE* f=std::fopen(path,"rb");
+  if(!f) return false;
+  unsigned char buf[1<<16];
+  for(size_t n;(n=std::fread(buf,1,sizeof buf,f))>0;) out.insert(out.end(),buf,buf+n);
+  bool ok=!std::ferror(f);
+  std::fclose(f);
+  return ok;
+}
+
+bool decodeImage(const char* path,AssetSource& a){
+  SDL_Surface* s=IMG_Load(path);
+  if(!s) return false;
+  SDL_Surface* rgba=SDL_ConvertSurfaceFormat(s,SDL_PIXELFORMAT_RGBA32,0);
+  SDL_FreeSurface(s);
+  if(!rgba) return false;
+  a.kind=ASSET_RGBA;
+  a.width=rgba->w;
+  a.height=rgba->h;
+  a.bytes.resize(size_t(rgba->w)*rgba->h*4);
+  // rows tightly packed, whatever the surface pitch
+  for(int y=0;y<rgba->h;++y){
+    const unsigned char* row=static_cast<const unsigned char*>(rgba->pixels)+size_t(y)*rgba->pitch;
+    std::copy(row,row+size_t(rgba->w)*4,a.bytes.begin()+long(size_t(y)*rgba->w*4));
+  }
+  SDL_FreeSurface(rgba);
+  return true;
+}
+
+} // namespace
+
+int main(int argc,char*argv[]){
+  const char* out=argc>1 ? argv[1] : ASSET_BUNDLE_FILE;
+  if(SDL_Init(0)<0 || !(IMG_Init(IMG_INIT_PNG)&IMG_INIT_PNG)){
+    std::cerr<<"SDL_image init failed: "<<IMG_GetError()<<"\n";
+    return 1;
+  }
+  const char* images[]={SPADE_IMG,HEART_IMG,DIAMOND_IMG,CLUB_IMG,CARDBACK_IMG,JACK_IMG,QUEEN_IMG,KING_IMG};
+  const char* raw[]={FONT_FILE,MOVE_SOUND_FILE};
+
+  std::vector<AssetSource> assets;
+  for(const char* path:images){
+    assets.emplace_back();
+    assets.back().name=path;
+    if(!decodeImage(path,assets.back())){ std::cerr<<path<<": "<<IMG_GetError()<<"\n"; return 1; }
+  }
+  for(const char* path:raw){
+    assets.emplace_back();
+    assets.back().name=path;
+    if(!readFile(path,assets.back().bytes)){ std::cerr<<"cannot read "<<path<<"\n"; return 1; }
+  }
+  if(!writeAssetBundle(out,assets)){ std::cerr<<"cannot write "<<out<<"\n"; return 1; }
+
+  size_t total=0;
+  for(const AssetSource& a:assets){
+    std::cerr<<"  "<<a.name;
+    if(a.kind==ASSET_RGBA) std::cerr<<" "<<a.width<<"x"<<a.height<<" RGBA";
+    std::cerr<<", "<<a.bytes.size()<<" bytes\n";
+    total+=a.bytes.size();
+  }
+  std::cerr<<assets.size()<<" assets, "<<total<<" bytes -> "<<out<<"\n";
+  IMG_Quit();
+  SDL_Quit();
+  return 0;
+}
@@ -0,0 +1,143 @@
+// tools/bench.cpp
+// Microbenchmarks for the rules engine hot paths. Reports time and heap
+// allocations per operation so regressions show up commit to commit:
+//   ./solitaire-bench [seconds-per-benchmark] [--threads N]
+// --threads also solves a few deals with ParallelSolver on N threads (0 =
+// all) and reports how the work spread across them.
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include "../include/Game.h"
+#include "../include/MoveGen.h"
+#include "../include/MoveJournal.h"
+#include "../include/Solver.h"
+
+namespace {
+uint64_t gAllocs=0;
+}
+
+// Count every heap allocation the benchmarked code makes
+void* operator new(std::size_t n){
+  ++gAllocs;
+  if(void* p=std::malloc(n ? n : 1)) return p;
+  throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p,std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+// Keep the optimizer from discarding a result
+template<class T> void keep(T const& v){ asm volatile("" : : "r"(&v) : "memory"); }
+
+double gMinSeconds=0.2;
+
+// Runs `op` in growing batches until a batch takes gMinSeconds, then
+// reports the last batch
+template<class Op>
+void bench(const char* name,Op&& op){
+  for(uint64_t iters=1024;;iters*=2){
+    uint64_t allocs=gAllocs;
+    auto t0=std::chrono::steady_clock::now();
+    for(uint64_t i=0;i<iters;++i) op();
+    double secs=std::chrono::duration<double>(std::chrono::steady_clock::now()-t0).count();
+    if(secs>=gMinSeconds || iters>=(1ull<<34)){
+      std::printf("%-28s %10.2f ns/op %8.3f allocs/op\n",name,secs*1e9/double(iters),
+                  double(gAllocs-allocs)/double(iters));
+      return;
+    }
+  }
+}
+
+Game dealt(uint64_t seed){
+  Game g;
+  g.initializeDeck(seed);
+  g.setupPiles();
+  return g;
+}
+
+const char* const STATUS_NAMES[]={"solved","unsolvable","unknown"}; // by SolveStatus
+// deals the sequential solver needs from 0.7 to over 2 million nodes for
+const uint64_t PARALLEL_SEEDS[]={1,21,34,40};
+
+void benchParallelSolve(int threads){
+  ParallelSolver solver(threads);
+  std::printf("\nParallelSolver, %d threads, draw 1\n",solver.threadCount());
+  for(uint64_t seed:PARALLEL_SEEDS){
+    auto t0=std::chrono::steady_clock::now();
+    SolveResult r=solver.solve(dealt(seed),1);
+    double secs=std::chrono::duration<double>(std::chrono::steady_clock::now()-t0).count();
+    std::printf("deal %llu: %s, %llu nodes in %.3f s\n",(unsigned long long)seed,
+                STATUS_NAMES[int(r.status)],(unsigned long long)r.nodes,secs);
+    for(size_t t=0;t<r.threads.size();++t){
+      const ThreadStats& s=r.threads[t];
+      std::printf("  thread %2zu %10llu nodes %6llu tasks %6llu steals %5.1f%% busy %12.0f nodes/s\n",t,
+                  (unsigned long long)s.nodes,(unsigned long long)s.tasks,(unsigned long long)s.steals,
+                  s.seconds>0 ? 100.0*s.busySeconds/s.seconds : 0.0,s.nodesPerSecond());
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc,char* argv[]){
+  int threads=-1; // -1 = no parallel solve
+  for(int i=1;i<argc;++i){
+    if(std::strcmp(argv[i],"--threads")==0 && i+1<argc) threads=std::atoi(argv[++i]);
+    else gMinSeconds=std::atof(argv[i]);
+  }
+
+  Game g;
+  g.initializeDeck(1);
+  bench("setupPiles",[&]{ g.setupPiles(); keep(g); });
+
+  g=dealt(1);
+  bench("handleStockClick (draw 1)",[&]{ g.handleStockClick(1); keep(g); });
+  g=dealt(1);
+  bench("handleStockClick (draw 3)",[&]{ g.handleStockClick(3); keep(g); });
+
+  // a four-card run onto a black six
+  CardStack run;
+  run.push_back(makeCard(5,1,true));
+  run.push_back(makeCard(4,0,true));
+  run.push_back(makeCard(3,2,true));
+  run.push_back(makeCard(2,3,true));
+  Pile dest{TABLEAU,{}};
+  dest.cards.push_back(makeCard(6,3,true));
+  bench("canMoveSequence (4 cards)",[&]{ bool ok=canMoveSequence(run,dest); keep(ok); });
+
+  // an ace on top of the first column, sent home and put back
+  g=dealt(1);
+  g.pushCard(FIRST_TABLEAU,makeCard(1,0,true));
+  int ace=int(g.piles[FIRST_TABLEAU].cards.size())-1;
+  bench("moveCardToFoundation+restore",[&]{
+    g.moveCardToFoundation(FIRST_TABLEAU,ace);
+    for(int f=FIRST_FOUNDATION;f<FIRST_TABLEAU;++f)
+      if(!g.piles[f].cards.empty()) g.pushCard(FIRST_TABLEAU,g.popCard(f));
+    keep(g);
+  });
+
+  // undo support: a journaled move and its undo, against the full-board
+  // copy the old snapshot stack took on every move
+  g=dealt(1);
+  MoveJournal journal;
+  bench("apply+record+undo (draw)",[&]{
+    Move m{};
+    g.stockMove(1,m);
+    g.applyMove(m);
+    journal.record(m);
+    g.undoMove(journal.undo());
+    keep(g);
+  });
+  Game snapshot;
+  bench("Game copy (snapshot)",[&]{ snapshot=g; keep(snapshot); });
+
+  MoveList moves;
+  g=dealt(1);
+  bench("generateMoves",[&]{ generateMoves(g,1,moves); keep(moves); });
+
+  if(threads>=0) benchParallelSolve(threads);
+  return 0;
+}
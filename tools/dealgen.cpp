@@ -0,0 +1,33 @@
+// tools/dealgen.cpp
+// Regenerates src/WinnableDeals.cpp:  ./dealgen [count] [threads] > src/WinnableDeals.cpp
+#include <cstdlib>
+#include <iostream>
+#include "../include/DealGenerator.h"
+
+int main(int argc,char*argv[]){
+  int count  =argc>1 ? std::atoi(argv[1]) : 16;
+  int threads=argc>2 ? std::atoi(argv[2]) : 0;
+  if(count<=0){ std::cerr<<"usage: dealgen [count] [threads]\n"; return 1; }
+
+  std::cout<<"// src/WinnableDeals.cpp\n"
+           <<"// Generated by tools/dealgen; do not edit by hand.\n"
+           <<"#include \"../include/DealPool.h\"\n\n"
+           <<"const int BUILTIN_WINNABLE_COUNT = "<<count<<";\n";
+  const int draws[2]={1,3};
+  for(int draw:draws){
+    for(int d=0;d<DIFFICULTY_COUNT;++d){
+      Difficulty diff=Difficulty(d);
+      std::cerr<<"draw "<<draw<<" "<<difficultyName(diff)<<"...\n";
+      auto seeds=findWinnableDeals(count,diff,draw,1,threads);
+      std::cout<<"\nstatic const uint64_t DRAW"<<draw<<"_"<<difficultyName(diff)<<"[] = {";
+      for(size_t i=0;i<seeds.size();++i)
+        std::cout<<(i%8 ? " " : "\n  ")<<seeds[i]<<"u,";
+      std::cout<<"\n};\n";
+    }
+  }
+  std::cout<<"\nconst uint64_t* const BUILTIN_WINNABLE_DEALS[2][DIFFICULTY_COUNT] = {\n"
+           <<"  { DRAW1_Easy, DRAW1_Medium, DRAW1_Hard },\n"
+           <<"  { DRAW3_Easy, DRAW3_Medium, DRAW3_Hard },\n"
+           <<"};\n";
+  return 0;
+}
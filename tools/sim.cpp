@@ -0,0 +1,192 @@
+// tools/sim.cpp
+// Headless self-play: plays a range of seeded deals with one bot policy on
+// every core and reports throughput, win rate and move-count distributions.
+//   ./solitaire-sim [--games N] [--first-seed S] [--policy random|greedy|solver]
+//                   [--draw 1|3] [--threads T] [--max-moves M] [--format csv|json]
+//                   [--replays FILE]
+// --replays appends every game to FILE as a varint length followed by the
+// encoded replay (see Replay.h).
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/Bot.h"
+#include "../include/Replay.h"
+
+namespace {
+
+struct Options {
+  uint64_t  games     = 10000;
+  uint64_t  firstSeed = 1;
+  BotPolicy policy    = BotPolicy::Greedy;
+  int       draw      = 1;
+  int       threads   = 0;
+  int       maxMoves  = 1000;
+  bool      json      = false;
+  std::string replays;
+};
+
+// Games and wins by final move count; index maxMoves+1 catches the rest
+struct Histogram {
+  std::vector<uint64_t> games, wins;
+  explicit Histogram(int maxMoves):games(maxMoves+2),wins(maxMoves+2){}
+  void add(const GameOutcome& o){
+    size_t i=std::min(size_t(o.moves),games.size()-1);
+    ++games[i];
+    if(o.won) ++wins[i];
+  }
+  void merge(const Histogram& h){
+    for(size_t i=0;i<games.size();++i){ games[i]+=h.games[i]; wins[i]+=h.wins[i]; }
+  }
+};
+
+struct Summary {
+  uint64_t n = 0;
+  double   mean = 0;
+  int      min = 0, p50 = 0, p90 = 0, p99 = 0, max = 0;
+};
+
+Summary summarize(const std::vector<uint64_t>& h){
+  Summary s;
+  double sum=0;
+  for(size_t i=0;i<h.size();++i){ s.n+=h[i]; sum+=double(i)*double(h[i]); }
+  if(s.n==0) return s;
+  s.mean=sum/double(s.n);
+  auto rank=[&](double q){
+    uint64_t target=uint64_t(q*double(s.n-1)), seen=0;
+    for(size_t i=0;i<h.size();++i){ seen+=h[i]; if(seen>target) return int(i); }
+    return int(h.size()-1);
+  };
+  s.min=rank(0); s.p50=rank(0.5); s.p90=rank(0.9); s.p99=rank(0.99); s.max=rank(1);
+  return s;
+}
+
+void printSummary(const char* name,const Summary& s,bool last){
+  std::cout<<"    \""<<name<<"\": {\"count\": "<<s.n<<", \"mean\": "<<s.mean
+           <<", \"min\": "<<s.min<<", \"p50\": "<<s.p50<<", \"p90\": "<<s.p90
+           <<", \"p99\": "<<s.p99<<", \"max\": "<<s.max<<"}"<<(last?"\n":",\n");
+}
+
+bool parseArgs(int argc,char* argv[],Options& o){
+  for(int i=1;i<argc;++i){
+    std::string a=argv[i];
+    if(i+1>=argc) return false;
+    const char* v=argv[++i];
+    if(a=="--games") o.games=std::strtoull(v,nullptr,10);
+    else if(a=="--first-seed") o.firstSeed=std::strtoull(v,nullptr,10);
+    else if(a=="--policy"){ if(!parsePolicy(v,o.policy)) return false; }
+    else if(a=="--draw") o.draw=std::atoi(v);
+    else if(a=="--threads") o.threads=std::atoi(v);
+    else if(a=="--max-moves") o.maxMoves=std::atoi(v);
+    else if(a=="--format"){
+      if(std::strcmp(v,"json")==0) o.json=true;
+      else if(std::strcmp(v,"csv")==0) o.json=false;
+      else return false;
+    }
+    else if(a=="--replays") o.replays=v;
+    else return false;
+  }
+  return (o.draw==1 || o.draw==3) && o.maxMoves>0;
+}
+
+} // namespace
+
+int main(int argc,char* argv[]){
+  Options o;
+  if(!parseArgs(argc,argv,o)){
+    std::cerr<<"usage: solitaire-sim [--games N] [--first-seed S] [--policy random|greedy|solver]\n"
+               "                     [--draw 1|3] [--threads T] [--max-moves M] [--format csv|json]\n"
+               "                     [--replays FILE]\n";
+    return 1;
+  }
+  if(o.threads<=0) o.threads=int(std::max(1u,std::thread::hardware_concurrency()));
+
+  // seeds are handed out in blocks so the shared counter stays cold
+  constexpr uint64_t BLOCK=256;
+  std::atomic<uint64_t> next{0}, done{0};
+  std::vector<Histogram> perThread(o.threads,Histogram(o.maxMoves));
+  auto start=std::chrono::steady_clock::now();
+
+  std::ofstream archive;
+  std::mutex archiveLock;
+  if(!o.replays.empty()){
+    archive.open(o.replays,std::ios::binary|std::ios::app);
+    if(!archive){ std::cerr<<"cannot open "<<o.replays<<"\n"; return 1; }
+  }
+
+  auto work=[&](int t){
+    Bot bot(o.policy,o.draw,o.maxMoves);
+    Histogram& h=perThread[t];
+    Replay replay;
+    std::vector<uint8_t> pending;
+    auto flush=[&]{
+      std::lock_guard<std::mutex> lock(archiveLock);
+      archive.write(reinterpret_cast<const char*>(pending.data()),std::streamsize(pending.size()));
+      pending.clear();
+    };
+    for(uint64_t b;(b=next.fetch_add(BLOCK))<o.games;){
+      uint64_t end=std::min(b+BLOCK,o.games);
+      for(uint64_t i=b;i<end;++i){
+        if(!archive.is_open()){ h.add(bot.play(o.firstSeed+i)); continue; }
+        replay.seed=o.firstSeed+i;
+        h.add(bot.play(replay.seed,&replay.moves));
+        std::vector<uint8_t> bytes=encodeReplay(replay);
+        for(uint64_t n=bytes.size();;n>>=7){
+          pending.push_back(uint8_t(n>=0x80 ? (n&0x7F)|0x80 : n));
+          if(n<0x80) break;
+        }
+        pending.insert(pending.end(),bytes.begin(),bytes.end());
+      }
+      if(pending.size()>(1u<<20)) flush();
+      uint64_t n=done+=end-b;
+      if(n/100000!=(n-(end-b))/100000) std::cerr<<n<<"/"<<o.games<<"\r";
+    }
+    if(!pending.empty()) flush();
+  };
+  std::vector<std::thread> pool;
+  for(int t=0;t<o.threads;++t) pool.emplace_back(work,t);
+  for(auto& t:pool) t.join();
+  double secs=std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+
+  Histogram total(o.maxMoves);
+  for(auto& h:perThread) total.merge(h);
+  Summary all=summarize(total.games), won=summarize(total.wins);
+  double winRate=o.games ? double(won.n)/double(o.games) : 0;
+  double rate=secs>0 ? double(o.games)/secs : 0;
+  std::cerr<<o.games<<" games ("<<policyName(o.policy)<<", draw "<<o.draw<<", "<<o.threads
+           <<" threads) in "<<secs<<" s: "<<rate<<" games/s, "<<won.n<<" won ("
+           <<winRate*100<<"%)\n";
+
+  if(o.json){
+    std::cout<<"{\n  \"policy\": \""<<policyName(o.policy)<<"\",\n  \"draw\": "<<o.draw
+             <<",\n  \"games\": "<<o.games<<",\n  \"firstSeed\": "<<o.firstSeed
+             <<",\n  \"threads\": "<<o.threads<<",\n  \"seconds\": "<<secs
+             <<",\n  \"gamesPerSecond\": "<<rate<<",\n  \"wins\": "<<won.n
+             <<",\n  \"winRate\": "<<winRate<<",\n  \"moves\": {\n";
+    printSummary("all",all,false);
+    printSummary("won",won,true);
+    std::cout<<"  },\n  \"histogram\": [";
+    bool first=true;
+    for(size_t i=0;i<total.games.size();++i){
+      if(!total.games[i]) continue;
+      std::cout<<(first?"\n":",\n")<<"    ["<<i<<", "<<total.games[i]<<", "<<total.wins[i]<<"]";
+      first=false;
+    }
+    std::cout<<"\n  ]\n}\n";
+  } else {
+    std::cout<<"# policy="<<policyName(o.policy)<<" draw="<<o.draw<<" games="<<o.games
+             <<" first_seed="<<o.firstSeed<<" threads="<<o.threads<<" seconds="<<secs
+             <<" games_per_sec="<<rate<<" wins="<<won.n<<" win_rate="<<winRate<<"\n";
+    std::cout<<"moves,games,wins\n";
+    for(size_t i=0;i<total.games.size();++i)
+      if(total.games[i]) std::cout<<i<<","<<total.games[i]<<","<<total.wins[i]<<"\n";
+  }
+  return 0;
+}